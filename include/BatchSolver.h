@@ -0,0 +1,37 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Batch solver.
+ *
+ * Solves every gameboard in a board file (@see BoardReader) with a strategy, on a pool of threads, and streams the
+ * results as CSV rows as they finish:
+ *
+ *     index,nTubes,tubeH,nColors,nMoves,t_ns,moves
+ *
+ * where index is the position of the gameboard in the file (from 0) and moves is the solution, as space-separated
+ * from>to pairs, and t_ns is the time to initialize the strategy and get every move from it. Gameboards that cannot be
+ * solved or read have -1 moves. Each thread keeps one strategy per board shape, so tables and caches are reused between
+ * gameboards.
+ */
+class BatchSolver {
+private:
+    size_t nThreads = 1;
+    std::string path;
+    std::vector<std::string> strategySpec;
+public:
+    /**
+     * @brief Parse batch from command-line arguments.
+     */
+    explicit BatchSolver(const std::vector<std::string> &arguments);
+    /**
+     * @brief Solve all gameboards, writing results to stdout.
+     */
+    void run() const;
+};
@@ -0,0 +1,97 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+#include "model/GameboardModel.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Benchmark of one strategy on one board.
+ *
+ * Runs in three separate phases:
+ * 1. One run to measure memory and check the solution;
+ * 2. Warm-up runs, that are not measured, so caches, tables and the allocator reach a steady state;
+ * 3. Timed runs, each measured on its own, with nothing written inside the timed region.
+ *
+ * Every run initializes the strategy and takes moves until the game is over, since some strategies (e.g. real-time
+ * search) do most of their work in next(); memory is read after the last move.
+ *
+ * Each timed run is measured in wall time and in CPU time of the whole process (so threads of the strategy are
+ * included), and the result is a single CSV row with a summary of the samples of each:
+ *
+ *     nTubes,tubeH,nColors,seed,nMoves,mem_b,runs,
+ *     wall_min_ns,wall_median_ns,wall_p90_ns,wall_mean_ns,wall_stddev_ns,
+ *     cpu_min_ns,cpu_median_ns,cpu_p90_ns,cpu_mean_ns,cpu_stddev_ns
+ *
+ * The minimum and median are the most stable estimates; a large gap between them, or between p90 and the median,
+ * means the measurements are noisy. The samples themselves can be written to a file as well.
+ *
+ * The process can be pinned to a CPU before anything runs; threads created afterwards inherit that affinity. The
+ * instruction set of the packed gameboard scanner can be forced as well (@see PackedBoard::setIsa), to compare its
+ * code paths.
+ */
+class Benchmark {
+public:
+    /**
+     * @brief Summary of a set of samples.
+     */
+    struct Summary {
+        double min = 0.0;
+        double median = 0.0;
+        double p90 = 0.0;
+        double mean = 0.0;
+        double stddev = 0.0;
+
+        /**
+         * @brief Summarize samples (in any order).
+         */
+        static Summary of(std::vector<double> samples);
+    };
+private:
+    size_t nWarmup = 1;
+    size_t nRuns = 10;
+    int cpu = -1;                   ///< @brief CPU to pin to, or -1 not to pin.
+    bool header = true;
+    std::string samplesPath;
+    GameboardModel gameboard;
+    std::unique_ptr<SearchStrategy> search;
+
+    /**
+     * @brief Get CPU time used by the process so far.
+     */
+    static std::chrono::nanoseconds cpuTime();
+
+    /**
+     * @brief Pin the calling thread (and threads it creates afterwards) to a CPU.
+     */
+    static void pin(int core);
+
+    /**
+     * @brief Force instruction set of the packed gameboard scanner, by name (scalar, sse2 or avx2).
+     *
+     * @throws std::runtime_error if the CPU does not support it
+     */
+    static void setIsa(const std::string &name);
+
+    /**
+     * @brief Initialize strategy and play its solution until the game is over.
+     *
+     * @return  Number of moves.
+     */
+    size_t play();
+public:
+    /**
+     * @brief Parse benchmark from command-line arguments.
+     */
+    explicit Benchmark(const std::vector<std::string> &arguments);
+    /**
+     * @brief Run benchmark, writing the summary to stdout.
+     */
+    void run();
+};
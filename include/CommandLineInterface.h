@@ -10,20 +10,49 @@
 #include "model/GameboardModel.h"
 #include "algorithm/SearchStrategy.h"
 #include "algorithm/heuristics/Heuristic.h"
+#include "algorithm/visited/BitstateVisitedSet.h"
 
 class CommandLineInterface {
 private:
     std::deque<std::string> args;
+    GameboardModel gameboard;
+    const BitstateVisitedSet *bitstate = nullptr;
 public:
     explicit CommandLineInterface(const std::vector<std::string> &arguments);
     void run();
-private:
     void printHelp() const;
+
+    /**
+     * @brief Parse <BOARD>; strategies parsed afterwards are built for that board.
+     */
+    GameboardModel parseBoard();
+    /**
+     * @brief Set board that strategies parsed afterwards are built for, instead of parsing it.
+     */
+    void setBoard(const GameboardModel &g);
+    /**
+     * @brief Parse <STRATEGY>.
+     */
+    SearchStrategy *parseStrategy();
+    /**
+     * @brief Get arguments not parsed yet, separated by spaces.
+     */
+    std::string remaining() const;
+private:
     void run_inside();
     GameboardModel board();
     SearchStrategy *strategy();
+    SearchStrategy *externalBreadthFirstSearch();
+    SearchStrategy *postOptimizedSearch();
+    SearchStrategy *cachedSearch();
     SearchStrategy *informed();
+    SearchStrategy *beamSearch(Heuristic *h);
+    SearchStrategy *anytimeAstarSearch(Heuristic *h);
+    SearchStrategy *rolloutSearch(Heuristic *h);
+    SearchStrategy *realTimeSearch(Heuristic *h);
+    VisitedSet *visitedSet();
     Heuristic *heuristic();
     Heuristic *nonAdmissibleHeuristic();
     Heuristic *finiteHorizonHeuristic();
+    Heuristic *patternDatabaseHeuristic();
 };
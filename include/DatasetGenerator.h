@@ -0,0 +1,57 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/BoardReader.h"
+#include "model/GameboardModel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Generator of gameboard datasets.
+ *
+ * Generates a number of random gameboards of the same shape (@see BoardGenerator) on a pool of threads, and writes them
+ * to a board file (@see BoardWriter). Gameboard i is generated from a seed derived from the dataset seed and i alone,
+ * so the same arguments always give the same file, whatever the number of threads.
+ *
+ * With a difficulty band, candidate gameboards are solved in parallel with a strategy (by default, A* with the
+ * admissible heuristic, which gives optimal solutions) and only those whose solution length is in the band are kept;
+ * candidates are accepted in order, so the result is still independent of the number of threads. The measurement of
+ * each gameboard is stored alongside the board file, in <file>.csv (or written to stderr if the board file is stdout),
+ * as CSV rows with the same columns as BatchSolver, where index is the position of the gameboard in the board file:
+ *
+ *     index,nTubes,tubeH,nColors,nMoves,t_ns,moves
+ */
+class DatasetGenerator {
+private:
+    size_t nThreads = 1;
+    size_t count;
+    size_t nTubes;
+    size_t tubeH;
+    size_t nColors;
+    uint64_t seed;
+    bool scramble = false;
+    size_t depth = 0;
+    bool band = false;
+    size_t minMoves = 0;
+    size_t maxMoves = 0;
+    std::vector<std::string> strategySpec;
+    std::string path;
+    BoardReader::Format format = BoardReader::BINARY;
+
+    GameboardModel generate(uint64_t i) const;
+    void runBand() const;
+public:
+    /**
+     * @brief Parse dataset from command-line arguments.
+     */
+    explicit DatasetGenerator(const std::vector<std::string> &arguments);
+    /**
+     * @brief Generate all gameboards, writing them to the output file.
+     */
+    void run() const;
+};
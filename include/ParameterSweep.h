@@ -0,0 +1,79 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parameter sweep.
+ *
+ * Runs a grid of boards (ranges of numbers of tubes, tube heights, numbers of colors and seeds) against a list of
+ * strategies, on a pool of threads inside one process, and streams the results as CSV rows as they finish:
+ *
+ *     alg,nTubes,tubeH,nColors,seed,nMoves,mem_b,t_ns
+ *
+ * Each row is prefixed with "<alg> ," like the analysis makefiles write them; failed runs have -1 in the last three
+ * columns. Each thread keeps the strategies it builds, so tables and caches are reused between boards. Larger boards
+ * are run first, so the sweep is not left waiting for one large board at the end.
+ *
+ * Each run initializes the strategy and plays its solution until the game is over, since some strategies (e.g. real-time
+ * search) do most of their work in next(). Timings are measured per run, but runs share the machine; use one thread for
+ * the most precise measurements. Memory is measured as in the command line interface: the peak memory held by the data
+ * structures of the strategy during the first run (@see SearchStrategy::getMemory), so it is not affected by other
+ * threads.
+ */
+class ParameterSweep {
+private:
+    struct Strategy {
+        std::string alg;
+        std::vector<std::string> spec;
+    };
+    struct Task {
+        size_t strategy;
+        size_t nTubes;
+        size_t tubeH;
+        size_t nColors;
+        unsigned seed;
+    };
+
+    size_t nThreads = 1;
+    size_t nRuns = 1;
+    bool header = true;
+    std::vector<Task> tasks;
+    std::vector<Strategy> strategies;
+
+    /**
+     * @brief Expand a range.
+     *
+     * A range is a comma-separated list of <a>, <a>:<b> or <a>:<b>:<step>. Bounds can also be given in terms of the
+     * number of tubes, as n, n-<k> or n/<k>.
+     *
+     * @param spec      Range
+     * @param nTubes    Number of tubes
+     */
+    static std::vector<size_t> expand(const std::string &spec, size_t nTubes);
+
+    /**
+     * @brief Run one task.
+     *
+     * @param task  Task
+     * @param built Strategies built by this thread, by specification and board shape
+     * @return      CSV row
+     */
+    std::string run(const Task &task, std::map<std::string, std::unique_ptr<SearchStrategy> > &built) const;
+public:
+    /**
+     * @brief Parse sweep from command-line arguments.
+     */
+    explicit ParameterSweep(const std::vector<std::string> &arguments);
+    /**
+     * @brief Run sweep, writing results to stdout.
+     */
+    void run() const;
+};
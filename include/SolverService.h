@@ -0,0 +1,115 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Solver service.
+ *
+ * Long-running process that answers solve requests, one per line, read from stdin or from the connections to a
+ * Unix-domain socket. A request has the syntax of the command line interface, with optional options:
+ *
+ *     [id <tag>] [budget <ms>] [memory <MB>] <BOARD> <STRATEGY>
+ *
+ * and is answered with one line, as soon as it is solved: the same CSV row as the command line interface (except that
+ * the time includes getting every move, as some strategies search while playing), -1 if no solution was found within
+ * budget, or "error <description>" if the request is invalid. If the request has an id, the
+ * reply is prefixed with it, as replies may come in a different order than requests.
+ *
+ * Requests are solved by a fixed pool of worker threads, shortest first: the size of the board is the estimate of how
+ * long a request takes, and requests of the same size are solved in the order they arrived. The queue of pending
+ * requests has a fixed capacity; when it is full, requests are not read until there is room, so clients are slowed
+ * down instead of the service running out of memory.
+ *
+ * The budget is a deadline counted from when the request arrives: a request that waits longer than that in the queue is
+ * not even started. The memory budget is approximate, as all requests share the process: a request is cancelled if the
+ * resident memory of the process grows by more than that while it runs.
+ *
+ * Strategies are kept between requests (per board shape and strategy specification), so anything they load or build
+ * (heuristic tables, pattern databases, solution caches) is reused; a strategy is only used by one request at a time.
+ */
+class SolverService {
+private:
+    using clock = std::chrono::steady_clock;
+
+    static const size_t MAX_IDLE_STRATEGIES = 64;
+
+    struct Connection;
+    struct Job;
+    /**
+     * @brief Order of jobs in the queue: shortest first, then first come first served.
+     */
+    struct JobOrder {
+        bool operator()(const std::shared_ptr<Job> &a, const std::shared_ptr<Job> &b) const;
+    };
+
+    size_t queueCapacity;
+    std::priority_queue<std::shared_ptr<Job>, std::vector<std::shared_ptr<Job> >, JobOrder> queue;
+    size_t nextSequence = 0;
+    bool stopping = false;
+    std::mutex m;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::vector<std::thread> workers;
+
+    std::multimap<std::string, std::unique_ptr<SearchStrategy> > idleStrategies;
+    std::mutex strategiesMutex;
+
+    /**
+     * @brief Serve requests read from a connection until end of file, and wait for all of them to be answered.
+     */
+    void session(const std::shared_ptr<Connection> &connection);
+    /**
+     * @brief Parse a request and queue it, waiting for room in the queue if needed.
+     */
+    void submit(const std::shared_ptr<Connection> &connection, const std::string &request);
+    /**
+     * @brief Main loop of a worker thread.
+     */
+    void work();
+    /**
+     * @brief Solve a job.
+     *
+     * @return  Reply line, without id and newline
+     */
+    std::string solve(Job &job);
+public:
+    /**
+     * @brief Construct solver service.
+     *
+     * @param nWorkers      Number of worker threads
+     * @param capacity      Maximum number of requests waiting to be solved
+     */
+    explicit SolverService(size_t nWorkers = 1, size_t capacity = 64);
+    SolverService(const SolverService &) = delete;
+    SolverService &operator=(const SolverService &) = delete;
+
+    /**
+     * @brief Serve requests from stdin, replying to stdout.
+     */
+    void serveStdin();
+
+    /**
+     * @brief Serve requests from connections to a Unix-domain socket; connections are served concurrently.
+     *
+     * @param path  Socket path; a stale socket at that path is replaced
+     */
+    [[noreturn]] void serveSocket(const std::string &path);
+
+    /**
+     * @brief Destructor; waits for queued requests to be solved.
+     */
+    ~SolverService();
+};
@@ -0,0 +1,78 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+#include "algorithm/heuristics/Heuristic.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Anytime repairing A* (ARA*).
+ *
+ * Runs weighted A* (priority g + w·h) starting with a large weight w, which quickly finds a first, possibly long,
+ * solution. The weight is then decreased by a fixed step and the search is resumed, reusing the costs, parents and
+ * open list of the previous iteration: states whose cost improved after being expanded are kept aside (the INCONS
+ * list) and only those are reconsidered, instead of searching from scratch. Each iteration yields a solution that is
+ * at most ε times longer than the optimal one, where ε is reported for each improvement.
+ *
+ * The search stops when the weight reaches 1 and that iteration finishes (the solution is then optimal if the
+ * heuristic is admissible and consistent), when the suboptimality bound proves the incumbent is optimal, or when the
+ * deadline passes, in which case the best solution found so far is used.
+ *
+ * Every improved solution is stored and can be retrieved with getImprovements(); a callback can also be set to be
+ * notified of each improvement as soon as it is found.
+ */
+class AnytimeAstarSearch: public SearchStrategy {
+public:
+    /**
+     * @brief Solution found by one iteration of the search.
+     */
+    struct Improvement {
+        double weight;                          ///< @brief Weight used in the iteration that found this solution.
+        double bound;                           ///< @brief Suboptimality bound ε of this solution.
+        std::chrono::nanoseconds elapsed;       ///< @brief Time since the search started.
+        std::deque<GameboardModel::Move> moves; ///< @brief Moves of the solution.
+    };
+private:
+    const Heuristic *h = nullptr;
+    double initialWeight;
+    double weightStep;
+    std::chrono::milliseconds deadline;
+    std::function<void(const Improvement &)> callback;
+    std::vector<Improvement> improvements;
+    CountedDeque<GameboardModel::Move> solution{memory};
+public:
+    /**
+     * @brief Construct anytime A* search.
+     *
+     * @param heuristic     Heuristic used to estimate the number of moves to a final state
+     * @param weight        Initial weight of the heuristic (values ≤ 1 make this a single A* search)
+     * @param step          Amount the weight is decreased by after each iteration
+     * @param deadlineMs    Time budget of initialize(const GameboardModel &), in milliseconds (0 for no deadline)
+     */
+    AnytimeAstarSearch(const Heuristic *heuristic, double weight, double step, long deadlineMs = 0);
+
+    /**
+     * @brief Set function to be called whenever a better solution is found.
+     *
+     * @param f     Callback
+     */
+    void setImprovementCallback(const std::function<void(const Improvement &)> &f);
+
+    /**
+     * @brief Get all solutions found during the last search, in the order they were found (each one shorter than the
+     * previous).
+     *
+     * @return  Improvements
+     */
+    const std::vector<Improvement> &getImprovements() const;
+
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    ~AnytimeAstarSearch() override;
+};
@@ -55,7 +55,7 @@
 class AstarSearch: public SearchStrategy {
 private:
     const Heuristic *h = nullptr;
-    std::deque<GameboardModel::Move> solution;
+    CountedDeque<GameboardModel::Move> solution{memory};
 public:
     /**
      * @brief Construct A* search from a heuristic.
@@ -67,5 +67,6 @@ public:
     explicit AstarSearch(const Heuristic *heuristic);
     void initialize(const GameboardModel &gameboard) override;
     GameboardModel::Move next() override;
+    bool isOptimal() const override;
     ~AstarSearch() override;
 };
@@ -0,0 +1,87 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Background solver.
+ *
+ * Runs a search strategy in a worker thread, so an interactive state can keep drawing and reading input while the
+ * solution is computed. Moves are published as soon as the strategy produces them, so strategies that plan as they
+ * play (like RealTimeSearch) make their first move available without waiting for the rest of the solution.
+ *
+ * Each call to submit(const GameboardModel &) replaces the gameboard being solved: a computation for an older
+ * gameboard is cancelled (@see SearchStrategy::cancel) and its result is discarded. If the new gameboard is the solved
+ * one after the first move of the current solution, the rest of that solution is reused instead.
+ *
+ * The search strategy is not owned, and must not be used by anyone else while the solver exists.
+ */
+class BackgroundSolver {
+public:
+    /**
+     * @brief Status of the solution for the current gameboard.
+     */
+    enum Status {
+        SOLVING,    ///< @brief Next move is still being computed.
+        SOLVED,     ///< @brief Next move is available (or the gameboard is solved).
+        FAILED      ///< @brief Strategy failed to find a solution.
+    };
+private:
+    SearchStrategy *strategy;
+
+    std::mutex m;
+    std::condition_variable cv;
+    bool stop = false;
+    bool hasPending = false;
+    size_t generation = 0;              ///< @brief Incremented on each submit.
+    GameboardModel current;             ///< @brief Gameboard of the current generation.
+    bool finished = true;               ///< @brief If the worker is done with the current generation.
+    bool failed = true;                 ///< @brief If the worker failed in the current generation.
+    std::deque<GameboardModel::Move> solution;  ///< @brief Moves published and not consumed yet.
+
+    std::thread worker;
+
+    void run();
+    Status status() const;
+public:
+    /**
+     * @brief Construct background solver, and start its worker thread.
+     *
+     * @param searchStrategy    Search strategy
+     */
+    explicit BackgroundSolver(SearchStrategy *searchStrategy);
+    BackgroundSolver(const BackgroundSolver &) = delete;
+    BackgroundSolver &operator=(const BackgroundSolver &) = delete;
+
+    /**
+     * @brief Start solving a gameboard, cancelling the solution of the previous one.
+     *
+     * @param gameboard     Gameboard
+     */
+    void submit(const GameboardModel &gameboard);
+
+    /**
+     * @brief Get status of the solution for the gameboard submitted last, without blocking.
+     */
+    Status getStatus();
+
+    /**
+     * @brief Wait for the next move of the solution of the gameboard submitted last, and get it.
+     *
+     * @return  First move of the solution, or Move(0,0) if the gameboard is already solved
+     * @throws  SearchStrategy::failed_to_find_solution if the strategy failed
+     */
+    GameboardModel::Move next();
+
+    /**
+     * @brief Cancel the current computation and stop the worker thread.
+     */
+    ~BackgroundSolver();
+};
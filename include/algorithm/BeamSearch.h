@@ -0,0 +1,49 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+#include "algorithm/SearchStrategy.h"
+#include "algorithm/heuristics/Heuristic.h"
+
+#include <deque>
+
+/**
+ * @brief Beam search.
+ *
+ * Breadth-first search where, at each depth (layer), only the `width` best states according to a heuristic are kept
+ * and expanded; all other states in that layer are discarded. States already kept in a previous layer, as well as
+ * repeated states within the same layer, are eliminated before ranking.
+ *
+ * Memory is bounded by width × depth, and time is roughly linear in the length of the solution, which makes beam
+ * search suitable for very large boards where an optimal answer is not required.
+ *
+ * Beam search is not complete: by discarding states it may lose all paths to a solution. If that happens, the search
+ * can be restarted a given number of times, each time with twice the width of the previous attempt.
+ *
+ * Does not guarantee the solution is optimal.
+ */
+class BeamSearch : public SearchStrategy {
+private:
+    const Heuristic *h = nullptr;
+    size_t width;
+    size_t restarts;
+    CountedDeque<GameboardModel::Move> solution{memory};
+
+    bool beam(const GameboardModel &src, size_t w);
+public:
+    /**
+     * @brief Construct beam search from heuristic, beam width and number of restarts.
+     *
+     * The heuristic is used to rank the states in each layer.
+     *
+     * @param heuristic     Heuristic
+     * @param beamWidth     Maximum number of states kept in each layer
+     * @param nRestarts     Number of times to retry with a doubled width if no solution is found
+     */
+    BeamSearch(const Heuristic *heuristic, size_t beamWidth, size_t nRestarts = 0);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    ~BeamSearch() override;
+};
@@ -15,12 +15,13 @@
  */
 class BreadthFirstSearch : public SearchStrategy {
 private:
-    std::stack<GameboardModel::Move> solution;
+    std::stack<GameboardModel::Move, CountedDeque<GameboardModel::Move> > solution{CountedDeque<GameboardModel::Move>(memory)};
     GameboardModel initialState;
     GameboardModel finalState;
-    std::map<GameboardModel, GameboardModel::Move> prev;
+    CountedMap<GameboardModel, GameboardModel::Move> prev{memory};
     bool bfs(const GameboardModel& GameboardModel);
 public:
     void initialize(const GameboardModel &gameboard) override;
     GameboardModel::Move next() override;
+    bool isOptimal() const override;
 };
@@ -0,0 +1,45 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+#include "algorithm/SolutionCache.h"
+
+#include <deque>
+#include <memory>
+
+/**
+ * @brief Cached search.
+ *
+ * Decorator of a search strategy that looks up the solution in a solution cache (@see SolutionCache) before searching,
+ * and stores the solutions it finds there. If the strategy is optimal, only optimal solutions are taken from the cache,
+ * so a shorter solution is searched for when the cache only has one found by a non-optimal strategy.
+ *
+ * The whole solution is computed in initialize(const GameboardModel &), so strategies that plan while playing
+ * (@see SearchStrategy::plansWhilePlaying) are better not wrapped.
+ */
+class CachedSearch: public SearchStrategy {
+private:
+    SearchStrategy *search;
+    std::shared_ptr<SolutionCache> cache;
+    CountedDeque<GameboardModel::Move> solution{memory};
+public:
+    /**
+     * @brief Construct cached search.
+     *
+     * @param searchStrategy    Strategy used on cache misses (is owned by this object)
+     * @param solutionCache     Solution cache
+     */
+    CachedSearch(SearchStrategy *searchStrategy, std::shared_ptr<SolutionCache> solutionCache);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    bool isOptimal() const override;
+    void cancel() override;
+    void resetCancel() override;
+    size_t getMemory() const override;
+    void resetMemoryPeak() override;
+    SearchStatistics getStatistics() const override;
+    void resetStatistics(bool timing = false) override;
+    ~CachedSearch() override;
+};
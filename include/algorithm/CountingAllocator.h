@@ -0,0 +1,106 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/MemoryCounter.h"
+#include "model/GameboardModel.h"
+
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Get heap memory owned by a value, besides its own size.
+ *
+ * Meant for values that own memory but cannot take an allocator, like GameboardModel; other types should use counted
+ * containers or strings instead. Overloads are found by argument-dependent lookup, so types local to a translation unit
+ * can overload it in their own namespace.
+ */
+template<class T> size_t heapSize(const T &) { return 0; }
+inline size_t heapSize(const GameboardModel &g) { return g.getHeapSize(); }
+template<class T, class U> size_t heapSize(const std::pair<T, U> &p) { return heapSize(p.first) + heapSize(p.second); }
+template<class... T> size_t heapSize(const std::tuple<T...> &t) {
+    return std::apply([](const T&... x){ return (size_t(0) + ... + heapSize(x)); }, t);
+}
+
+/**
+ * @brief Allocator that accounts the memory of a container in a MemoryCounter.
+ *
+ * Memory is taken from std::allocator. Besides the memory allocated by the container itself, the heap memory owned by
+ * each element (@see heapSize) is accounted when the element is constructed and released when it is destroyed, so a
+ * container of gameboards accounts for the tubes of those gameboards as well.
+ *
+ * That is only exact if elements do not change the memory they own while in the container, and if moving an element
+ * copies that memory instead of stealing it (as GameboardModel, which has no move constructor) or the container never
+ * moves its elements (node-based containers). Both hold for the states kept by the search strategies, which are not
+ * modified after being inserted.
+ */
+template<class T>
+class CountingAllocator {
+    template<class U> friend class CountingAllocator;
+private:
+    MemoryCounter *counter;
+public:
+    typedef T value_type;
+
+    /**
+     * @brief Construct allocator that accounts in a counter, which must outlive all containers using it.
+     */
+    CountingAllocator(MemoryCounter &memoryCounter) noexcept: counter(&memoryCounter) {}
+    template<class U> CountingAllocator(const CountingAllocator<U> &other) noexcept: counter(other.counter) {}
+
+    T *allocate(size_t n) {
+        T *ret = std::allocator<T>().allocate(n);
+        counter->allocate(n * sizeof(T));
+        return ret;
+    }
+    void deallocate(T *p, size_t n) noexcept {
+        counter->deallocate(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<class U, class... Args> void construct(U *p, Args&&... args) {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        counter->allocate(heapSize(*p));
+    }
+    template<class U> void destroy(U *p) {
+        counter->deallocate(heapSize(*p));
+        p->~U();
+    }
+
+    template<class U> bool operator==(const CountingAllocator<U> &other) const { return counter == other.counter; }
+    template<class U> bool operator!=(const CountingAllocator<U> &other) const { return counter != other.counter; }
+};
+
+template<class T> using CountedVector = std::vector<T, CountingAllocator<T> >;
+template<class T> using CountedDeque = std::deque<T, CountingAllocator<T> >;
+template<class T> using CountedList = std::list<T, CountingAllocator<T> >;
+template<class K, class C = std::less<K> > using CountedSet = std::set<K, C, CountingAllocator<K> >;
+template<class K, class V, class C = std::less<K> >
+using CountedMap = std::map<K, V, C, CountingAllocator< std::pair<const K, V> > >;
+template<class K, class H = std::hash<K>, class E = std::equal_to<K> >
+using CountedUnorderedSet = std::unordered_set<K, H, E, CountingAllocator<K> >;
+template<class K, class V, class H = std::hash<K>, class E = std::equal_to<K> >
+using CountedUnorderedMap = std::unordered_map<K, V, H, E, CountingAllocator< std::pair<const K, V> > >;
+typedef std::basic_string<char, std::char_traits<char>, CountingAllocator<char> > CountedString;
+
+namespace std {
+    /**
+     * @brief Hash a counted string, as the string with the same contents.
+     */
+    template <> struct hash<CountedString> {
+        size_t operator()(const CountedString &s) const noexcept {
+            return hash<string_view>()(string_view(s.data(), s.size()));
+        }
+    };
+}
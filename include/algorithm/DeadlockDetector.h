@@ -0,0 +1,61 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+
+/**
+ * @brief Deadlock detector.
+ *
+ * Recognizes gameboards from which no final state can be reached, so they can be rejected before a search explores
+ * their whole reachable space, and so dead states can be pruned during the search.
+ *
+ * Three checks are available, from cheapest to most expensive:
+ * 1. isMalformed: a final state needs every color to fill a whole number of tubes, so if the number of pieces of some
+ * color is not a multiple of the tube height, no final state is reachable.
+ * 2. isDead: a state that is not final and has no valid moves.
+ * 3. analyse: besides the previous checks, explores the states reachable from a gameboard up to a budget; if all of them
+ * are explored without finding a final state, the gameboard is stuck in a region with no way out (e.g. where the only
+ * moves shuffle pieces between the same tubes back and forth).
+ */
+class DeadlockDetector {
+public:
+    /**
+     * @brief Result of analyse.
+     */
+    enum Verdict {
+        DEAD,       ///< @brief No final state is reachable.
+        ALIVE,      ///< @brief A final state is reachable.
+        UNKNOWN     ///< @brief Budget was exhausted.
+    };
+private:
+    size_t budget;
+public:
+    /**
+     * @brief Construct deadlock detector.
+     *
+     * @param closureBudget Maximum number of states analyse explores
+     */
+    explicit DeadlockDetector(size_t closureBudget = 64);
+
+    /**
+     * @brief Check if the pieces of a gameboard can never form a final state.
+     */
+    static bool isMalformed(const GameboardModel &g);
+
+    /**
+     * @brief Check if a gameboard is not final and has no valid moves.
+     *
+     * Stops at the first valid move, so it is much cheaper than GameboardModel::getAllMoves.
+     */
+    static bool isDead(const GameboardModel &g);
+
+    /**
+     * @brief Analyse if a final state can be reached from a gameboard.
+     *
+     * @param g     Gameboard
+     * @return      Verdict
+     */
+    Verdict analyse(const GameboardModel &g) const;
+};
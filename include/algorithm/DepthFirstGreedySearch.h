@@ -6,6 +6,7 @@
 #include "model/GameboardModel.h"
 #include "algorithm/SearchStrategy.h"
 #include "algorithm/heuristics/Heuristic.h"
+#include "algorithm/visited/VisitedSet.h"
 
 #include <deque>
 #include <set>
@@ -27,8 +28,8 @@
 class DepthFirstGreedySearch : public SearchStrategy {
 private:
     const Heuristic *h = nullptr;
-    std::deque<GameboardModel::Move> solution;
-    std::set<GameboardModel> visited;
+    CountedDeque<GameboardModel::Move> solution{memory};
+    VisitedSet *visited = nullptr;
 
     bool dfs(const GameboardModel& gameBoard);
 public:
@@ -38,9 +39,12 @@ public:
      * The heuristic is used to rank states.
      *
      * @param heuristic     Heuristic
+     * @param visitedSet    Set of visited states to be used (owned by this object), or nullptr for an exact set
      */
-    explicit DepthFirstGreedySearch(const Heuristic *heuristic);
+    explicit DepthFirstGreedySearch(const Heuristic *heuristic, VisitedSet *visitedSet = nullptr);
 
     void initialize(const GameboardModel &gameboardModel) override;
     GameboardModel::Move next() override;
+    size_t getMemory() const override;
+    ~DepthFirstGreedySearch() override;
 };
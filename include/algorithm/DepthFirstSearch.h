@@ -5,6 +5,7 @@
 
 #include "model/GameboardModel.h"
 #include "algorithm/SearchStrategy.h"
+#include "algorithm/visited/VisitedSet.h"
 
 #include <bits/stdc++.h>
 #include <deque>
@@ -14,14 +15,25 @@
  * @brief Depth-first search.
  *
  * Keeps track of visited nodes (nodes added to the path so far) so as to avoid cycles.
+ *
+ * By default visited nodes are kept in an ExactVisitedSet, but any VisitedSet can be used (e.g., a BitstateVisitedSet
+ * to bound memory).
  */
 class DepthFirstSearch : public SearchStrategy {
 private:
-    std::deque<GameboardModel::Move> solution;
-    std::set<GameboardModel> visited;
+    CountedDeque<GameboardModel::Move> solution{memory};
+    VisitedSet *visited = nullptr;
 
     bool dfs(const GameboardModel& gameBoard);
 public:
+    /**
+     * @brief Construct DFS.
+     *
+     * @param visitedSet    Set of visited states to be used (owned by this object), or nullptr for an exact set
+     */
+    explicit DepthFirstSearch(VisitedSet *visitedSet = nullptr);
     void initialize(const GameboardModel &gameboardModel) override;
     GameboardModel::Move next() override;
+    size_t getMemory() const override;
+    ~DepthFirstSearch() override;
 };
@@ -0,0 +1,61 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+#include "algorithm/SearchStrategy.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @brief External-memory breadth-first search with delayed duplicate detection.
+ *
+ * Breadth-first search where each layer (the set of states at a given distance from the initial state) is stored on
+ * disk as a sorted file of packed states (@see GameboardModel::pack), so the amount of RAM used does not depend on the
+ * number of reachable states.
+ *
+ * To build layer d+1, the states of layer d are streamed from disk and expanded; their successors are collected in a
+ * fixed-size buffer which, whenever full, is sorted and written as a run file. The runs are then merged with a heap,
+ * dropping duplicates, and the result is subtracted from the union of the previous layers (kept as one more sorted
+ * file) by a streaming merge, which is possible because all files are sorted. Duplicates are thus only detected once
+ * per layer (delayed), using sequential disk accesses. At most a fixed number of files is merged at once, so when there
+ * are more runs than that, they are first merged in several passes; the number of open files stays bounded however
+ * many states there are.
+ * States are expanded and goal-tested directly in packed form (@see PackedBoard), without unpacking them.
+ *
+ * In undirected graphs it is enough to subtract the previous two layers; in this game a move cannot always be
+ * reversed, so a state can be reached again many layers later, and all previous layers are subtracted.
+ *
+ * The solution is reconstructed by a backward pass over the layer files: starting at the goal, the predecessors of the
+ * current state are generated and looked up in the previous layer by binary search.
+ *
+ * All files are removed once the search finishes. The solution is optimal.
+ */
+class ExternalBreadthFirstSearch : public SearchStrategy {
+private:
+    std::string directory;
+    size_t bufferStates;
+    std::string prefix;
+    std::vector<std::string> layers;
+    std::string closed;                 ///< @brief Sorted union of all layers so far.
+    CountedDeque<GameboardModel::Move> solution{memory};
+
+    std::string fileName(const std::string &what, size_t i) const;
+    void removeFiles();
+    size_t expandLayer(GameboardModel &model, std::vector<uint8_t> &goal, bool &found);
+public:
+    /**
+     * @brief Construct external-memory BFS.
+     *
+     * @param dir       Directory where layer files are written
+     * @param buffer    Number of states kept in memory before a sorted run is written to disk
+     */
+    explicit ExternalBreadthFirstSearch(const std::string &dir, size_t buffer = 1u << 20);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    bool isOptimal() const override;
+    ~ExternalBreadthFirstSearch() override;
+};
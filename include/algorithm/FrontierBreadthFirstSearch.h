@@ -0,0 +1,59 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+#include "algorithm/SearchStrategy.h"
+
+#include <deque>
+#include <functional>
+
+/**
+ * @brief Breadth-first frontier search.
+ *
+ * Breadth-first search that does not keep a closed list: only the layer being expanded and the layer being generated
+ * are in memory, so peak memory is proportional to the widest layer instead of the whole reachable space.
+ *
+ * To prevent generating states of the previous layer again, each state keeps a set of used-operator bits: when state v
+ * is generated from u by a move that can be reversed, the reverse move is marked as used in v, so v never generates u.
+ * In this game some moves cannot be reversed, so a state can still be generated again in a later layer; that only
+ * causes redundant work, as every state is first generated in the layer corresponding to its distance. If a layer
+ * ever repeats, the search is known to be cycling and stops.
+ *
+ * As there are no parent pointers, the solution is recovered by divide and conquer: a first search finds the goal and
+ * its depth D; a second search from the initial state to that goal records, for every state, its ancestor at depth D/2
+ * (the relay layer), which gives a state in the middle of an optimal path. The two halves are then solved recursively
+ * the same way.
+ *
+ * The solution is optimal.
+ */
+class FrontierBreadthFirstSearch : public SearchStrategy {
+private:
+    CountedDeque<GameboardModel::Move> solution{memory};
+
+    /**
+     * @brief Run frontier search.
+     *
+     * @param src           Initial state
+     * @param isGoal        Predicate that tells if a state is a goal
+     * @param relayDepth    Depth of the relay layer
+     * @param maxDepth      Maximum depth to search
+     * @param goal          Goal state found
+     * @param depth         Depth of goal
+     * @param relay         Ancestor of goal in the relay layer (or src if the goal is not below the relay layer)
+     * @return              True if a goal was found, false otherwise
+     */
+    bool search(const GameboardModel &src, const std::function<bool(const GameboardModel &)> &isGoal,
+                size_t relayDepth, size_t maxDepth,
+                GameboardModel &goal, size_t &depth, GameboardModel &relay) const;
+
+    /**
+     * @brief Append to the solution an optimal path from src to dst, knowing they are at distance d.
+     */
+    void solve(const GameboardModel &src, const GameboardModel &dst, size_t d);
+public:
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    bool isOptimal() const override;
+};
@@ -22,7 +22,7 @@
 class GreedySearch : public SearchStrategy {
 private:
     const Heuristic *h = nullptr;
-    std::list<GameboardModel::Move> solution;
+    CountedList<GameboardModel::Move> solution{memory};
 public:
     /**
      * @brief Construct greedy search from heuristic.
@@ -5,6 +5,7 @@
 
 #include "model/GameboardModel.h"
 #include "algorithm/SearchStrategy.h"
+#include "algorithm/visited/VisitedSet.h"
 
 #include <bits/stdc++.h>
 #include <deque>
@@ -21,15 +22,27 @@
  *
  * It is better than DFS if the optimal path length is considerably smaller than the number of possible states, and if
  * the branching factor is not too large.
+ *
+ * By default visited nodes are kept in an ExactVisitedSet, but any VisitedSet can be used; a set that does not support
+ * removal (such as BitstateVisitedSet) remembers states across branches, so the solution may not be optimal.
  */
 class IterativeDeepeningSearch : public SearchStrategy {
 private:
-    std::deque<GameboardModel::Move> solution;
-    std::set<GameboardModel> visited;
+    CountedDeque<GameboardModel::Move> solution{memory};
+    VisitedSet *visited = nullptr;
     size_t maxDepth;
 
     bool dfs(const GameboardModel& gameBoard, size_t depth);
 public:
+    /**
+     * @brief Construct iterative deepening DFS.
+     *
+     * @param visitedSet    Set of visited states to be used (owned by this object), or nullptr for an exact set
+     */
+    explicit IterativeDeepeningSearch(VisitedSet *visitedSet = nullptr);
     void initialize(const GameboardModel &gameboardModel) override;
     GameboardModel::Move next() override;
+    bool isOptimal() const override;
+    size_t getMemory() const override;
+    ~IterativeDeepeningSearch() override;
 };
@@ -0,0 +1,34 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Counter of memory in use.
+ *
+ * Keeps the number of bytes currently held by the containers that report to it (@see CountingAllocator), and the
+ * maximum of that number since construction or the last call to resetPeak(). Can be updated from several threads.
+ */
+class MemoryCounter {
+private:
+    std::atomic<size_t> current{0};
+    std::atomic<size_t> peak{0};
+public:
+    MemoryCounter() = default;
+    MemoryCounter(const MemoryCounter &) = delete;
+    MemoryCounter &operator=(const MemoryCounter &) = delete;
+
+    void allocate(size_t bytes);        ///< @brief Account bytes that were acquired.
+    void deallocate(size_t bytes);      ///< @brief Account bytes that were released.
+
+    size_t getCurrent() const;          ///< @brief Get number of bytes in use.
+    size_t getPeak() const;             ///< @brief Get maximum number of bytes in use.
+
+    /**
+     * @brief Start measuring peak memory again, from the memory currently in use.
+     */
+    void resetPeak();
+};
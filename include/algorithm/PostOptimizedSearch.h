@@ -0,0 +1,50 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+
+#include <deque>
+
+/**
+ * @brief Post-optimized search.
+ *
+ * Decorator of a search strategy that shortens the solutions it finds, meant for strategies that find long solutions
+ * quickly (depth-first, greedy).
+ *
+ * The solution is seen as the sequence of states it goes through. From each state of that sequence, a breadth-first
+ * search bounded by depth (the window) and number of states looks for a later state of the sequence, or any final
+ * state, that can be reached in fewer moves than the solution takes; the best shortcut found (the one that saves more
+ * moves) replaces that part of the solution. A state that appears more than once is found at depth 0, so cycles are
+ * removed along the way.
+ *
+ * The result is never longer than the original solution, and is locally optimal: no part of it with at most window
+ * moves can be replaced by a shorter path (as long as the state budget is not exhausted).
+ */
+class PostOptimizedSearch: public SearchStrategy {
+private:
+    SearchStrategy *search;
+    size_t window;
+    size_t budget;
+    CountedDeque<GameboardModel::Move> solution{memory};
+public:
+    /**
+     * @brief Construct post-optimized search.
+     *
+     * @param searchStrategy    Strategy whose solutions are to be optimized (is owned by this object)
+     * @param windowSize        Maximum length of shortcuts
+     * @param stateBudget       Maximum number of states explored by each search for a shortcut
+     */
+    PostOptimizedSearch(SearchStrategy *searchStrategy, size_t windowSize, size_t stateBudget = 4000);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    bool isOptimal() const override;
+    void cancel() override;
+    void resetCancel() override;
+    size_t getMemory() const override;
+    void resetMemoryPeak() override;
+    SearchStatistics getStatistics() const override;
+    void resetStatistics(bool timing = false) override;
+    ~PostOptimizedSearch() override;
+};
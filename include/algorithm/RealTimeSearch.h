@@ -0,0 +1,57 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+#include "algorithm/heuristics/Heuristic.h"
+
+#include <chrono>
+
+/**
+ * @brief Real-time adaptive A* (RTAA*).
+ *
+ * Real-time search: instead of planning a whole solution in initialize(const GameboardModel &), each call to next()
+ * does a bounded amount of work (a limited number of expansions and/or a time budget) and commits to a single move, so
+ * the time to the first move does not depend on the size of the gameboard.
+ *
+ * On each call to next(), an A* search is run from the current state until it expands the lookahead number of states,
+ * spends its time budget, or picks a final state. Let s* be the best state in the open list, with f(s*) = g(s*) + h(s*);
+ * the heuristic of every expanded state s is then learned to be f(s*) - g(s), which never decreases it if the heuristic
+ * is consistent and makes the agent avoid repeatedly visiting the same states. The agent moves one step along the path
+ * to s*. If the search picks a final state, the whole path to it is followed without further searching.
+ *
+ * Learned values are kept until the next call to initialize(const GameboardModel &). The solution is not optimal.
+ * Some moves of this game cannot be reversed, so the agent may commit to a region of the state space with no final
+ * state; next() throws failed_to_find_solution once the local search proves it.
+ */
+class RealTimeSearch: public SearchStrategy {
+public:
+    typedef Heuristic::heuristic_t heuristic_t;
+private:
+    const Heuristic *h = nullptr;
+    size_t lookahead;
+    std::chrono::milliseconds budget;
+    GameboardModel current;
+    CountedMap<GameboardModel, heuristic_t> learned{memory};
+    CountedDeque<GameboardModel::Move> plan{memory};
+
+    /**
+     * @brief Evaluate successors of a state, using the learned values where available.
+     */
+    void evaluateMoves(const GameboardModel &u, const std::vector<GameboardModel::Move> &moves,
+                       std::vector<heuristic_t> &out) const;
+public:
+    /**
+     * @brief Construct real-time search.
+     *
+     * @param heuristic     Heuristic
+     * @param lookahead     Maximum number of states expanded per move (at least 1)
+     * @param moveBudgetMs  Time budget per move, in milliseconds (0 for no time budget)
+     */
+    RealTimeSearch(const Heuristic *heuristic, size_t lookahead, long moveBudgetMs = 0);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    bool plansWhilePlaying() const override;
+    ~RealTimeSearch() override;
+};
@@ -0,0 +1,61 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+#include "algorithm/SearchStrategy.h"
+#include "algorithm/heuristics/Heuristic.h"
+
+#include <deque>
+#include <set>
+
+/**
+ * @brief Recursive best-first search (RBFS).
+ *
+ * Memory-bounded alternative to A*: it expands states in best-first order (by g + h, just as A*), but only keeps in
+ * memory the current path and the siblings of the states in that path, so memory is linear in the depth of the search
+ * instead of growing with the number of expanded states.
+ *
+ * Each recursive call is given an upper bound, which is the f-value of the best alternative path anywhere above it.
+ * When the best child exceeds that bound, the subtree is forgotten and the call unwinds, but the subtree's best f-value
+ * is backed up into its root, so that the subtree is regenerated later only if it becomes the most promising one
+ * again. Gracefully trades time (regenerating forgotten subtrees) for memory.
+ *
+ * Cycles are avoided by never generating states that are already in the current path.
+ *
+ * If the heuristic is admissible, the solution is optimal.
+ */
+class RecursiveBestFirstSearch : public SearchStrategy {
+private:
+    const Heuristic *h = nullptr;
+    CountedDeque<GameboardModel::Move> solution{memory};
+    CountedSet<GameboardModel> path{memory};
+
+    /**
+     * @brief Search below a state.
+     *
+     * @param u         State to search from
+     * @param g         Distance from the initial state to u
+     * @param fu        Static f-value of u (g plus its heuristic), computed when u was generated
+     * @param F         Backed-up f-value of u
+     * @param bound     f-value of the best alternative path
+     * @param found     Set to true if a solution was found
+     * @return          New backed-up f-value of u
+     */
+    Heuristic::heuristic_t rbfs(const GameboardModel &u, size_t g, Heuristic::heuristic_t fu, Heuristic::heuristic_t F,
+                                Heuristic::heuristic_t bound, bool &found);
+public:
+    /**
+     * @brief Construct RBFS from a heuristic.
+     *
+     * The heuristic is used to estimate the number of moves from the current state to any final state.
+     *
+     * @param heuristic Heuristic
+     */
+    explicit RecursiveBestFirstSearch(const Heuristic *heuristic);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    bool isOptimal() const override;
+    ~RecursiveBestFirstSearch() override;
+};
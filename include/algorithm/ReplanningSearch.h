@@ -0,0 +1,53 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+
+/**
+ * @brief Replanning search.
+ *
+ * Decorator of a search strategy, meant for hints: it keeps a plan, that maps every state of the solutions found so far to
+ * the next move towards the goal, and each initialization for a new gameboard reuses it as much as possible.
+ * 1. If the gameboard is in the plan, the plan is followed from there; no search is needed.
+ * 2. Otherwise, a breadth-first search with a bounded number of states looks for the closest state in the plan; if one
+ * is found, the path to it is added to the plan.
+ * 3. Otherwise, the decorated strategy is used to plan from scratch.
+ *
+ * In the common case where the user follows the hints or deviates from them by a few moves, the cost does not depend on
+ * the size of the gameboard. Solutions are as good as those of the decorated strategy, plus the repair.
+ */
+class ReplanningSearch: public SearchStrategy {
+private:
+    SearchStrategy *search;
+    size_t repairBudget;
+    CountedMap<GameboardModel, GameboardModel::Move> plan{memory};  ///< @brief Next move towards the goal, for known states.
+    GameboardModel current;
+
+    /**
+     * @brief Search for the closest state in the plan, and add the path to it to the plan.
+     *
+     * @param src   Initial state
+     * @return      True if a state in the plan was found within budget, false otherwise
+     */
+    bool repair(const GameboardModel &src);
+public:
+    /**
+     * @brief Construct replanning search.
+     *
+     * @param searchStrategy    Strategy used to plan from scratch (is owned by this object)
+     * @param budget            Maximum number of states explored when repairing the plan
+     */
+    explicit ReplanningSearch(SearchStrategy *searchStrategy, size_t budget = 4096);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    bool plansWhilePlaying() const override;
+    void cancel() override;
+    void resetCancel() override;
+    size_t getMemory() const override;
+    void resetMemoryPeak() override;
+    SearchStatistics getStatistics() const override;
+    void resetStatistics(bool timing = false) override;
+    ~ReplanningSearch() override;
+};
@@ -0,0 +1,69 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "algorithm/SearchStrategy.h"
+#include "algorithm/heuristics/Heuristic.h"
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+/**
+ * @brief Monte-Carlo rollout search.
+ *
+ * Performs many randomized playouts from the initial state, and keeps the shortest one that reaches a final state. It
+ * gives an answer in bounded time on boards far too large for systematic search, although it is usually not optimal.
+ *
+ * On each step of a playout, a move is chosen at random among those that lead to a state not yet visited in that
+ * playout, with probability proportional to exp(-(h(v) - h_min)/T), where h_min is the best score among the candidates
+ * and T is the temperature: T → 0 is greedy search with random tie-breaking, and large T is a uniform random walk.
+ * If there is no such move, the playout backtracks one move. A playout fails if it takes more steps (moves and
+ * backtracks) than allowed.
+ *
+ * Playout i uses its own random generator, seeded with (seed, i), and is not cut short by the playouts found by other
+ * threads (since it backtracks, a playout that goes deeper than another may still end up shorter). The shortest playout
+ * is chosen after all of them end, with ties broken by the smallest i; the result is therefore reproducible and does
+ * not depend on the number of threads, unless the deadline stops the search early. The heuristic is shared by all threads, so it must be safe to call concurrently
+ * (which is the case for all heuristics that do not have mutable state).
+ */
+class RolloutSearch: public SearchStrategy {
+private:
+    const Heuristic *h = nullptr;
+    size_t nRollouts;
+    size_t maxSteps;
+    double temperature;
+    unsigned seed;
+    size_t nThreads;
+    std::chrono::milliseconds deadline;
+    CountedDeque<GameboardModel::Move> solution{memory};
+
+    /**
+     * @brief Run one playout.
+     *
+     * @param src       Initial state
+     * @param i         Index of playout
+     * @param path      Moves of the playout, if it succeeds
+     * @param s         Statistics of the calling thread, where the playout is accounted
+     * @return          True if the playout reached a final state, false otherwise
+     */
+    bool rollout(const GameboardModel &src, size_t i, std::vector<GameboardModel::Move> &path, SearchStatistics &s) const;
+public:
+    /**
+     * @brief Construct rollout search.
+     *
+     * @param heuristic     Heuristic used to bias playouts
+     * @param rollouts      Number of playouts
+     * @param steps         Maximum number of steps of a playout
+     * @param T             Temperature
+     * @param s             Seed
+     * @param threads       Number of threads (0 for the number of hardware threads)
+     * @param deadlineMs    Time budget of initialize(const GameboardModel &), in milliseconds (0 for no deadline)
+     */
+    RolloutSearch(const Heuristic *heuristic, size_t rollouts, size_t steps, double T, unsigned s = 0,
+                  size_t threads = 1, long deadlineMs = 0);
+    void initialize(const GameboardModel &gameboard) override;
+    GameboardModel::Move next() override;
+    ~RolloutSearch() override;
+};
@@ -0,0 +1,90 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Statistics of a search.
+ *
+ * Cheap counters updated by search strategies as they run, to tell why a strategy is slow or large. Counters are
+ * always collected; the time spent in each phase is only measured if timing is enabled, as reading the clock is not
+ * negligible compared to the phases themselves.
+ *
+ * A state is expanded when its moves are generated, and each of those moves generates a state; generated states
+ * that were already known (and are discarded) are duplicates, and known states found again through a shorter path
+ * and queued again are reopened.
+ */
+struct SearchStatistics {
+    size_t expanded = 0;                            ///< @brief Number of states expanded.
+    size_t generated = 0;                           ///< @brief Number of states generated.
+    size_t duplicates = 0;                          ///< @brief Number of generated states that were already known.
+    size_t reopened = 0;                            ///< @brief Number of states reopened.
+    size_t maxOpen = 0;                             ///< @brief Maximum size of the open list, or of the path.
+    size_t heuristicEvaluations = 0;                ///< @brief Number of states evaluated by the heuristic.
+    std::chrono::nanoseconds moveTime{0};           ///< @brief Time generating moves.
+    std::chrono::nanoseconds heuristicTime{0};      ///< @brief Time evaluating the heuristic.
+    std::chrono::nanoseconds lookupTime{0};         ///< @brief Time looking up and inserting states in sets and maps.
+    bool timing = false;                            ///< @brief If the time of each phase is measured.
+
+    /**
+     * @brief Measures the time of a phase, from construction to destruction, if timing is enabled.
+     */
+    class Timer {
+    private:
+        std::chrono::nanoseconds *total;
+        std::chrono::steady_clock::time_point begin;
+    public:
+        /**
+         * @brief Start measuring.
+         *
+         * @param stats     Statistics
+         * @param phase     Time of the phase the measurement is added to
+         */
+        Timer(SearchStatistics &stats, std::chrono::nanoseconds SearchStatistics::*phase);
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+        ~Timer();
+    };
+
+    /**
+     * @brief Update maximum size of the open list.
+     */
+    void updateOpen(size_t size);
+
+    /**
+     * @brief Add statistics of another search, e.g. of a decorated strategy.
+     */
+    SearchStatistics &operator+=(const SearchStatistics &s);
+
+    /**
+     * @brief Get effective branching factor.
+     *
+     * That is the branching factor b* of the uniform tree of depth d with as many states as were generated:
+     * generated + 1 = 1 + b* + b*² + ... + b*^d.
+     *
+     * @param depth     Depth of the solution found
+     * @return          Effective branching factor, or 0 if depth is 0
+     */
+    double getEffectiveBranchingFactor(size_t depth) const;
+
+    /**
+     * @brief Get names of the CSV columns written by toCsv(size_t).
+     */
+    static std::string csvHeader();
+    /**
+     * @brief Write as CSV columns, without a leading or trailing comma.
+     *
+     * @param depth     Depth of the solution found, for the effective branching factor
+     */
+    std::string toCsv(size_t depth) const;
+    /**
+     * @brief Write as a JSON object.
+     *
+     * @param depth     Depth of the solution found, for the effective branching factor
+     */
+    std::string toJson(size_t depth) const;
+};
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <stdexcept>
+#include "algorithm/CountingAllocator.h"
+#include "algorithm/SearchStatistics.h"
+#include "algorithm/heuristics/Heuristic.h"
 #include "model/GameboardModel.h"
 
 /**
@@ -37,7 +41,60 @@ public:
         explicit failed_to_find_solution(const std::string &what_arg);
     };
 private:
-    size_t mem = 0;
+    std::atomic<bool> cancelled{false};
+protected:
+    /**
+     * @brief Memory held by the data structures of the strategy.
+     *
+     * Containers of a strategy (open list, closed set, parent map, solution...) report to it through a
+     * CountingAllocator, so getMemory() measures those and nothing else in the process.
+     */
+    mutable MemoryCounter memory;
+
+    /**
+     * @brief Statistics of the search, updated by the strategy (@see getStatistics).
+     */
+    mutable SearchStatistics stats;
+
+    /**
+     * @brief Get all moves of a state, accounting its expansion and the states generated (@see stats).
+     */
+    std::vector<GameboardModel::Move> expand(const GameboardModel &u) const;
+
+    /**
+     * @brief Evaluate a state with a heuristic, accounting the evaluation (@see stats).
+     */
+    Heuristic::heuristic_t evaluate(const Heuristic &h, const GameboardModel &g) const;
+
+    /**
+     * @brief Evaluate successors of a state with a heuristic, accounting the evaluations (@see stats).
+     *
+     * @see Heuristic::evaluateMoves
+     */
+    void evaluate(const Heuristic &h, const GameboardModel &parent, const std::vector<GameboardModel::Move> &moves,
+                  Heuristic::heuristic_t *out) const;
+
+    /**
+     * @brief Abort the search if cancel() was called.
+     *
+     * Meant to be called periodically in the main loop of a search.
+     *
+     * @param strategyName  Name of the strategy, used in the exception message
+     * @throws failed_to_find_solution if cancellation was requested
+     */
+    void checkCancelled(const std::string &strategyName) const;
+
+    /**
+     * @brief Reject a gameboard from which no final state can be reached (@see DeadlockDetector::analyse).
+     *
+     * Meant to be called at the start of initialize(const GameboardModel &), so hopeless gameboards are rejected before
+     * their reachable space is explored.
+     *
+     * @param gameboard     Initial state
+     * @param strategyName  Name of the strategy, used in the exception message
+     * @throws failed_to_find_solution if the gameboard was proven to be unsolvable
+     */
+    static void checkSolvable(const GameboardModel &gameboard, const std::string &strategyName);
 public:
     /**
      * @brief Initialize search strategy with initial state.
@@ -52,6 +109,33 @@ public:
      */
     virtual GameboardModel::Move next() = 0;
 
+    /**
+     * @brief Request the search running in another thread to stop.
+     *
+     * The running initialize(const GameboardModel &) or next() throws failed_to_find_solution soon after. The request
+     * holds until resetCancel() is called.
+     */
+    virtual void cancel();
+    /**
+     * @brief Clear cancellation request, so the strategy can be used again.
+     */
+    virtual void resetCancel();
+    /**
+     * @brief Check if cancellation was requested.
+     */
+    bool isCancelled() const;
+
+    /**
+     * @brief Check if the solutions found are guaranteed to be optimal.
+     */
+    virtual bool isOptimal() const;
+    /**
+     * @brief Check if the strategy does its search in next(), as it plays, instead of in initialize().
+     *
+     * Such strategies must not be run to the end up front (e.g. to cache their solution), or they lose their point.
+     */
+    virtual bool plansWhilePlaying() const;
+
     /**
      * @brief Destructor.
      */
@@ -60,7 +144,29 @@ public:
     /**
      * @brief Get maximum amount of memory used by search strategy.
      *
+     * That is the peak of the memory held by its data structures (@see memory) since construction or the last call to
+     * resetMemoryPeak(); memory of the call stack and of heuristics is not included.
+     *
      * @return Maximum amount of memory, in bytes
      */
-    size_t getMemory() const;
+    virtual size_t getMemory() const;
+    /**
+     * @brief Start measuring peak memory again, from the memory held now.
+     *
+     * Meant to be called before initialize(const GameboardModel &), to measure the memory of a single search.
+     */
+    virtual void resetMemoryPeak();
+
+    /**
+     * @brief Get statistics of the searches since construction or the last call to resetStatistics(bool).
+     */
+    virtual SearchStatistics getStatistics() const;
+    /**
+     * @brief Clear statistics.
+     *
+     * Meant to be called before initialize(const GameboardModel &), to get the statistics of a single search.
+     *
+     * @param timing    If the time of each phase is to be measured, which makes searches slower
+     */
+    virtual void resetStatistics(bool timing = false);
 };
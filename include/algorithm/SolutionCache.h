@@ -0,0 +1,97 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Persistent cache of solutions.
+ *
+ * Stores, for every state of every solution it was given, the next move and the number of moves left; so any state on
+ * a stored solution can answer the rest of it. Each record also tells if its solution is known to be optimal; every
+ * suffix of an optimal solution is optimal too. When a state is stored more than once, an optimal solution is preferred,
+ * and otherwise the shortest one is kept.
+ *
+ * Tubes are interchangeable, so states are identified by a 64-bit hash of their canonical form (packed, with tubes
+ * sorted), and moves are stored in terms of the sorted tubes; a gameboard with the same tubes in another order is
+ * answered as well. Solutions read from the cache are replayed and checked, so a hash collision can only cause a miss.
+ *
+ * The file is an append-only log of fixed-size records, shared by all processes that use it: it is memory-mapped and
+ * scanned into an index when opened, and new records are appended with a single write. If the file cannot be opened
+ * for writing, the cache still works, but only in memory.
+ */
+class SolutionCache {
+public:
+    /**
+     * @brief Record of the cache file.
+     */
+    struct Record {
+        uint64_t key;           ///< @brief Hash of the canonical state.
+        uint16_t from;          ///< @brief Next move, in canonical tube indices.
+        uint16_t to;            ///< @brief Next move, in canonical tube indices.
+        uint32_t remaining;     ///< @brief Number of moves left, including the next move; OPTIMAL bit if optimal.
+    };
+    /**
+     * @brief Bit of Record::remaining set if the solution is optimal (never set by older versions of the cache).
+     */
+    static const uint32_t OPTIMAL = uint32_t(1) << 31;
+private:
+    int fd = -1;
+    std::unordered_map<uint64_t, Record> index;
+    mutable std::mutex m;
+
+    void load();
+    /**
+     * @brief Get key of a state, and the canonical index of each of its tubes.
+     */
+    static uint64_t canonicalize(const GameboardModel &g, std::vector<size_t> &canonicalIndex);
+public:
+    /**
+     * @brief Open cache stored in a file, creating the file if it does not exist.
+     *
+     * @param path  File path
+     */
+    explicit SolutionCache(const std::string &path);
+    SolutionCache(const SolutionCache &) = delete;
+    SolutionCache &operator=(const SolutionCache &) = delete;
+
+    /**
+     * @brief Get a solution cache, reusing the instance already open in this process for the same file if there is one.
+     */
+    static std::shared_ptr<SolutionCache> open(const std::string &path);
+
+    /**
+     * @brief Get stored solution of a gameboard.
+     *
+     * @param gameboard       Initial state
+     * @param moves           Where the solution is written
+     * @param requireOptimal  If only an optimal solution is to be returned
+     * @return                True if a solution was found, false otherwise
+     */
+    bool lookup(const GameboardModel &gameboard, std::vector<GameboardModel::Move> &moves,
+                bool requireOptimal = false) const;
+
+    /**
+     * @brief Store a solution of a gameboard.
+     *
+     * @param gameboard Initial state
+     * @param moves     Solution
+     * @param optimal   If the solution is known to be optimal
+     */
+    void store(const GameboardModel &gameboard, const std::vector<GameboardModel::Move> &moves, bool optimal = false);
+
+    /**
+     * @brief Get number of states in the cache.
+     */
+    size_t size() const;
+
+    ~SolutionCache();
+};
@@ -23,4 +23,14 @@
 class AdmissibleHeuristic: public Heuristic {
 public:
     heuristic_t operator()(const GameboardModel &g) const override;
+    /**
+     * @brief Evaluate successors incrementally.
+     *
+     * Both factors only depend on the size, bottom color and f(t) of each tube, and a move only changes two tubes; so
+     * these are computed once for the parent, and each successor only recomputes the colors whose tubes changed.
+     * Results are the same as those of operator().
+     */
+    void evaluateMoves(const GameboardModel &parent, const std::vector<GameboardModel::Move> &moves,
+                       heuristic_t *out) const override;
+    bool isAdmissible() const override;
 };
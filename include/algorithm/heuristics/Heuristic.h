@@ -5,6 +5,8 @@
 
 #include "model/GameboardModel.h"
 
+#include <vector>
+
 /**
  * @brief Heuristic class.
  *
@@ -34,6 +36,23 @@ public:
      * @return      Score of that gameboard
      */
     virtual heuristic_t operator()(const GameboardModel &g) const = 0;
+    /**
+     * @brief Evaluate all successors of a state, in a single call.
+     *
+     * Heuristics can override this to share work among siblings, e.g. by computing what does not depend on the move
+     * only once for the parent. The default implementation applies each move to a copy of the parent and evaluates it
+     * with operator().
+     *
+     * @param parent    Gameboard whose successors are evaluated
+     * @param moves     Valid moves of parent
+     * @param out       Array with moves.size() elements, where out[i] is set to the score of parent after moves[i]
+     */
+    virtual void evaluateMoves(const GameboardModel &parent, const std::vector<GameboardModel::Move> &moves,
+                               heuristic_t *out) const;
+    /**
+     * @brief Check if the heuristic is known to be admissible (i.e. never overestimates the number of moves left).
+     */
+    virtual bool isAdmissible() const;
     /**
      * @brief Destructor.
      */
@@ -19,5 +19,7 @@ private:
 public:
     NonAdmissibleHeuristic(const Heuristic *heuristic, double factor);
     heuristic_t operator()(const GameboardModel &g) const override;
+    void evaluateMoves(const GameboardModel &parent, const std::vector<GameboardModel::Move> &moves,
+                       heuristic_t *out) const override;
     ~NonAdmissibleHeuristic();
 };
@@ -0,0 +1,111 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Pattern database.
+ *
+ * Table of exact distances to a goal in an abstraction of the game, where only the colors in a pattern are kept and
+ * all other colors are treated as a single, indistinguishable color. Every move in the original game is also a move in
+ * the abstraction, so the distance in the abstraction never overestimates the real distance.
+ *
+ * Tubes are interchangeable, so abstract states are stored in canonical form (tubes sorted), which makes the table
+ * considerably smaller.
+ *
+ * The table is computed once, by a backward breadth-first search from the abstract goal state, and saved to a file;
+ * afterwards, that file is memory-mapped, so it loads instantly and is shared by all processes using it. The file is an
+ * open-addressing hash table of 64-bit slots, each one with a 56-bit fingerprint of an abstract state and its distance.
+ *
+ * In additive mode, only moves of pieces with a color in the pattern are counted; the values of several additive
+ * databases with disjoint patterns can then be added together and still be admissible.
+ */
+class PatternDatabase {
+public:
+    /**
+     * @brief Value returned for abstract states from which the goal cannot be reached.
+     */
+    static const uint8_t UNREACHABLE = 255;
+private:
+    size_t nTubes;
+    size_t tubeH;
+    size_t nColors;
+    std::vector<color_t> pattern;
+    bool additive;
+    std::vector<uint8_t> symbols;   ///< @brief Abstract symbol of each color.
+
+    void *data = nullptr;
+    size_t dataSize = 0;
+    const uint64_t *slots = nullptr;
+    uint64_t mask = 0;
+
+    bool load(const std::string &path);
+    void build(const std::string &path) const;
+public:
+    /**
+     * @brief Open the pattern database stored in a file, building it first if the file does not exist or was built
+     * for other parameters.
+     *
+     * @param path      File path
+     * @param nTubes    Number of tubes
+     * @param tubeH     Tube height
+     * @param nColors   Number of colors
+     * @param pattern   Colors kept in the abstraction
+     * @param additive  If only moves of pieces with colors in the pattern are to be counted
+     */
+    PatternDatabase(const std::string &path, size_t nTubes, size_t tubeH, size_t nColors,
+                    const std::vector<color_t> &pattern, bool additive);
+    PatternDatabase(const PatternDatabase &) = delete;
+    PatternDatabase &operator=(const PatternDatabase &) = delete;
+
+    /**
+     * @brief Get a pattern database, reusing the instance already open in this process for the same file if there is
+     * one.
+     *
+     * @see PatternDatabase(const std::string &, size_t, size_t, size_t, const std::vector<color_t> &, bool)
+     */
+    static std::shared_ptr<const PatternDatabase> open(const std::string &path, size_t nTubes, size_t tubeH,
+                                                       size_t nColors, const std::vector<color_t> &pattern,
+                                                       bool additive);
+
+    /**
+     * @brief Get size of abstract states, in bytes.
+     */
+    size_t abstractSize() const;
+
+    /**
+     * @brief Write abstract state of a gameboard, in canonical form.
+     *
+     * @param g     Gameboard, with the same dimensions and number of colors as this database
+     * @param out   Destination, with abstractSize() bytes
+     */
+    void abstract(const GameboardModel &g, uint8_t *out) const;
+
+    /**
+     * @brief Get distance of an abstract state.
+     *
+     * @param canonical Abstract state, in canonical form
+     * @return          Distance to the goal in the abstraction, or UNREACHABLE
+     */
+    uint8_t lookup(const uint8_t *canonical) const;
+
+    /**
+     * @brief Get distance of the abstract state of a gameboard.
+     *
+     * @param g     Gameboard
+     * @return      Distance to the goal in the abstraction, or UNREACHABLE
+     */
+    uint8_t lookup(const GameboardModel &g) const;
+
+    const std::vector<color_t> &getPattern() const;     ///< @brief Get colors kept in the abstraction.
+    bool isAdditive() const;                            ///< @brief Check if database is additive.
+
+    ~PatternDatabase();
+};
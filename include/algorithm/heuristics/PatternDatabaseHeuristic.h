@@ -0,0 +1,33 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "Heuristic.h"
+#include "PatternDatabase.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Pattern database heuristic.
+ *
+ * Admissible heuristic that combines the values of one or more pattern databases (@see PatternDatabase).
+ *
+ * If the databases are additive, their patterns must be disjoint and their values are added; otherwise the maximum of
+ * their values is used.
+ */
+class PatternDatabaseHeuristic: public Heuristic {
+private:
+    std::vector< std::shared_ptr<const PatternDatabase> > databases;
+    bool additive;
+public:
+    /**
+     * @brief Construct pattern database heuristic.
+     *
+     * @param dbs       Pattern databases; all must be additive, or none
+     */
+    explicit PatternDatabaseHeuristic(const std::vector< std::shared_ptr<const PatternDatabase> > &dbs);
+    heuristic_t operator()(const GameboardModel &g) const override;
+    bool isAdmissible() const override;
+};
@@ -0,0 +1,65 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "VisitedSet.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Lossy set of visited states, using bitstate hashing (a Bloom filter).
+ *
+ * States are not stored; instead, each state sets k bits of a fixed-size bit array, chosen by k hash functions, and a
+ * state is considered visited if all of its k bits are set. Memory is fixed (2^log2Bits bits) regardless of how many
+ * states are visited, at the cost of a small probability of reporting an unvisited state as visited (and thus wrongly
+ * pruning it from the search); states are never reported as unvisited after being inserted.
+ *
+ * Removal is not possible, so erase(const GameboardModel &) does nothing: depth-first strategies that unmark states
+ * when backtracking will instead remember all states they ever visited.
+ */
+class BitstateVisitedSet: public VisitedSet {
+private:
+    std::vector<uint64_t> bits;
+    uint64_t mask;
+    size_t k;
+    size_t nSet = 0;
+    size_t nInserted = 0;
+public:
+    /**
+     * @brief Construct bitstate visited set.
+     *
+     * @param log2Bits  Base-2 logarithm of the number of bits (e.g., 25 uses 4 MiB)
+     * @param nHashes   Number of hash functions (bits set per state)
+     */
+    BitstateVisitedSet(size_t log2Bits, size_t nHashes);
+
+    bool contains(const GameboardModel &g) const override;
+    void insert(const GameboardModel &g) override;
+    void erase(const GameboardModel &g) override;
+    void clear() override;
+
+    /**
+     * @brief Get estimated probability that a state not yet visited is reported as visited.
+     *
+     * Computed from the current fraction f of bits that are set, as f^k.
+     *
+     * @return  Estimated omission probability
+     */
+    double getOmissionProbability() const;
+
+    /**
+     * @brief Get number of insertions of states that were not reported as visited before.
+     *
+     * @return  Number of insertions
+     */
+    size_t getNumberOfInsertions() const;
+
+    /**
+     * @brief Get memory used by the bit array.
+     *
+     * @return  Size of the bit array, in bytes
+     */
+    size_t getMemory() const override;
+};
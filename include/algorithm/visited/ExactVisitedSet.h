@@ -0,0 +1,24 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "VisitedSet.h"
+#include "algorithm/CountingAllocator.h"
+
+/**
+ * @brief Exact set of visited states.
+ *
+ * Stores every visited state, so it never gives wrong answers, but memory grows with the number of states visited.
+ */
+class ExactVisitedSet: public VisitedSet {
+private:
+    MemoryCounter memory;
+    CountedSet<GameboardModel> visited{memory};
+public:
+    bool contains(const GameboardModel &g) const override;
+    void insert(const GameboardModel &g) override;
+    void erase(const GameboardModel &g) override;
+    void clear() override;
+    size_t getMemory() const override;
+};
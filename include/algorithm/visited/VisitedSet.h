@@ -0,0 +1,49 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+
+/**
+ * @brief Set of visited states.
+ *
+ * Provides an interface for the structure used by depth-first strategies to remember which states were already
+ * visited, so that different trade-offs between memory and exactness can be used.
+ */
+class VisitedSet {
+public:
+    /**
+     * @brief Check if a state was visited.
+     *
+     * @param g     State
+     * @return      True if the state is (or is believed to be) in the set, false otherwise
+     */
+    virtual bool contains(const GameboardModel &g) const = 0;
+    /**
+     * @brief Mark a state as visited.
+     *
+     * @param g     State
+     */
+    virtual void insert(const GameboardModel &g) = 0;
+    /**
+     * @brief Unmark a state as visited, if the implementation supports removal.
+     *
+     * @param g     State
+     */
+    virtual void erase(const GameboardModel &g) = 0;
+    /**
+     * @brief Remove all states from the set.
+     */
+    virtual void clear() = 0;
+    /**
+     * @brief Get maximum amount of memory used by the set since it was last cleared.
+     *
+     * @return  Maximum amount of memory, in bytes
+     */
+    virtual size_t getMemory() const = 0;
+    /**
+     * @brief Destructor.
+     */
+    virtual ~VisitedSet();
+};
@@ -51,6 +51,8 @@ public:
     virtual State* run() = 0;
     virtual ~State();
 
+    static const char *const solutionCachePath; ///< @brief File of the solution cache shared by the interactive states
+
     static MainMenuState                     *mainMenuState                    ; ///< @brief Main menu state instance
     static PlayHumanState                    *playHumanState                   ; ///< @brief Play human state instance
     static ChooseStrategyState               *chooseMachineState               ; ///< @brief Choose strategy state instance
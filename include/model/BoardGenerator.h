@@ -0,0 +1,62 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief Generator of random gameboards.
+ *
+ * Unlike GameboardModel::fillRandom, each generator has its own random number generator, so generators can be used in
+ * parallel, and gameboards are generated in time linear in their size. Every color has as many pieces as the tube
+ * height.
+ *
+ * For the same seed, a generator always produces the same sequence of gameboards.
+ */
+class BoardGenerator {
+private:
+    std::mt19937_64 rng;
+
+    static void check(size_t nTubes, size_t tubeH, size_t nColors);
+public:
+    /**
+     * @brief Construct generator.
+     *
+     * @param seed  Seed
+     */
+    explicit BoardGenerator(uint64_t seed);
+
+    /**
+     * @brief Get seed of the i-th gameboard of a dataset, so each gameboard can be generated independently.
+     */
+    static uint64_t seedOf(uint64_t seed, uint64_t i);
+
+    /**
+     * @brief Generate gameboard by shuffling.
+     *
+     * All pieces are shuffled, and laid in slots chosen uniformly at random. The gameboard may not be solvable.
+     *
+     * @param nTubes    Number of tubes
+     * @param tubeH     Tube height
+     * @param nColors   Number of colors
+     */
+    GameboardModel shuffled(size_t nTubes, size_t tubeH, size_t nColors);
+
+    /**
+     * @brief Generate gameboard by scrambling a final state.
+     *
+     * Starts at a final state (each color in its own tube, in random tubes) and takes random moves backwards: the
+     * result is always solvable, in at most depth moves. The walk does not revisit states while it can avoid it, so
+     * larger depths give gameboards farther from the goal.
+     *
+     * @param nTubes    Number of tubes
+     * @param tubeH     Tube height
+     * @param nColors   Number of colors
+     * @param depth     Number of moves backwards
+     */
+    GameboardModel scrambled(size_t nTubes, size_t tubeH, size_t nColors, size_t depth);
+};
@@ -0,0 +1,64 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+
+#include <string>
+
+/**
+ * @brief Reader of board files.
+ *
+ * A board file holds a sequence of gameboards, in one of two formats:
+ * - Text: one gameboard per line, in text representation (@see GameboardModel::toText); empty lines and lines starting
+ *   with # are ignored.
+ * - Binary: the 8-byte magic "BSBOARD\1", followed by one record per gameboard: the number of tubes and the tube height,
+ *   as 16-bit little-endian integers, followed by its packed representation (@see GameboardModel::pack).
+ *
+ * The file is memory-mapped and read sequentially, so files much larger than memory can be read.
+ */
+class BoardReader {
+public:
+    /**
+     * @brief Format of a board file.
+     */
+    enum Format {
+        TEXT,
+        BINARY
+    };
+
+    static const char MAGIC[8];     ///< @brief Magic at the start of binary board files.
+private:
+    const char *data = nullptr;
+    size_t dataSize = 0;
+    size_t pos = 0;
+    size_t line = 0;
+    Format format = TEXT;
+public:
+    /**
+     * @brief Open board file; its format is detected.
+     *
+     * @param path  File path
+     * @throws std::runtime_error if the file cannot be read
+     */
+    explicit BoardReader(const std::string &path);
+    BoardReader(const BoardReader &) = delete;
+    BoardReader &operator=(const BoardReader &) = delete;
+
+    /**
+     * @brief Get format of the file.
+     */
+    Format getFormat() const;
+
+    /**
+     * @brief Read next gameboard.
+     *
+     * @param gameboard Where the gameboard is read to
+     * @return          True if a gameboard was read, false if the end of the file was reached
+     * @throws std::invalid_argument if the gameboard is malformed
+     */
+    bool next(GameboardModel &gameboard);
+
+    ~BoardReader();
+};
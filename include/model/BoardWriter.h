@@ -0,0 +1,45 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/BoardReader.h"
+
+#include <cstdio>
+#include <string>
+
+/**
+ * @brief Writer of board files. @see BoardReader
+ */
+class BoardWriter {
+private:
+    FILE *file;
+    BoardReader::Format format;
+public:
+    /**
+     * @brief Create board file.
+     *
+     * @param path  File path, or - for stdout
+     * @param fmt   Format
+     * @throws std::runtime_error if the file cannot be created
+     */
+    BoardWriter(const std::string &path, BoardReader::Format fmt);
+    BoardWriter(const BoardWriter &) = delete;
+    BoardWriter &operator=(const BoardWriter &) = delete;
+
+    /**
+     * @brief Write gameboard.
+     *
+     * @throws std::runtime_error if writing fails
+     */
+    void write(const GameboardModel &gameboard);
+
+    /**
+     * @brief Flush and close file.
+     *
+     * @throws std::runtime_error if writing fails
+     */
+    void close();
+
+    ~BoardWriter();
+};
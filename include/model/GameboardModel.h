@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <string>
 #include <vector>
 #include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 
 /**
  * @brief Color of a piece in the gameboard.
@@ -164,6 +168,15 @@ public:
      */
     std::vector<Move> getAllMoves() const;
 
+    /**
+     * @brief Get all moves that, applied to some other gameboard, produce the current gameboard.
+     *
+     * Applying reverseMove(const Move &) with any of these moves yields a predecessor of the current gameboard.
+     *
+     * @return std::vector<Move>
+     */
+    std::vector<Move> getAllReverseMoves() const;
+
     /**
      * @brief Get all boards reachable by one move from the current one
      * 
@@ -189,6 +202,74 @@ public:
     bool operator>=(const GameboardModel &model) const;
 
     unsigned getSeed() const;
+
+    /**
+     * @brief Get heap memory owned by this gameboard.
+     *
+     * That is the array of tubes plus the storage of each tube, estimated from the allocation pattern of std::deque.
+     *
+     * @return  Number of bytes
+     */
+    size_t getHeapSize() const;
+
+    /**
+     * @brief Get size of the packed representation of this gameboard.
+     *
+     * @return  Number of bytes, which is the number of slots (number of tubes × tube height)
+     */
+    size_t packedSize() const;
+
+    /**
+     * @brief Write packed representation of this gameboard.
+     *
+     * The packed representation has one byte per slot: tube i occupies bytes [i·H, (i+1)·H), from bottom to top; each
+     * byte is 0 if the slot is empty, or the color of the piece plus one otherwise. Comparing two packed gameboards
+     * byte by byte is consistent with operator==.
+     *
+     * @param out   Destination, with at least packedSize() bytes
+     */
+    void pack(uint8_t *out) const;
+
+    /**
+     * @brief Read packed representation into this gameboard.
+     *
+     * The number of tubes, tube height and number of colors of this gameboard are kept, so they must match those of the
+     * gameboard the representation was created from.
+     *
+     * @param in    Source, with packedSize() bytes
+     */
+    void unpack(const uint8_t *in);
+
+    /**
+     * @brief Read packed representation of a gameboard of any shape into this gameboard.
+     *
+     * The number of colors is set to one more than the largest color found, and the seed to 0.
+     *
+     * @param num_tubes     Number of tubes
+     * @param tube_height   Tube height
+     * @param in            Source, with num_tubes × tube_height bytes
+     */
+    void unpack(size_t num_tubes, size_t tube_height, const uint8_t *in);
+
+    /**
+     * @brief Get text representation of this gameboard.
+     *
+     * The text representation is the tube height, followed by a colon and the tubes separated by slashes; each tube
+     * is written from bottom to top, one character per piece (colors 0 to 61 are written as 0-9, a-z, A-Z). For
+     * instance, "4:0011/1100//" has four tubes of height 4, the last two of which are empty.
+     *
+     * @throws std::invalid_argument if there are colors that cannot be written
+     */
+    std::string toText() const;
+
+    /**
+     * @brief Read text representation into this gameboard. @see toText()
+     *
+     * The number of colors is set as in unpack(size_t, size_t, const uint8_t *).
+     *
+     * @throws std::invalid_argument if the text is malformed
+     */
+    void fromText(const std::string &text);
 };
 
 namespace std {
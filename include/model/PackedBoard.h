@@ -0,0 +1,117 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#pragma once
+
+#include "model/GameboardModel.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Scanner of packed gameboards.
+ *
+ * Analyses a gameboard in packed representation (@see GameboardModel::pack) without unpacking it, and answers the same
+ * questions as GameboardModel with bit-identical results: goal test, valid moves, and size, top color and number of
+ * same-color pieces at the bottom of each tube.
+ *
+ * All of those derive from two bitmaps computed by load(): which slots are not empty, and which slots hold the same
+ * byte as the slot above them. Those are data-parallel byte comparisons, computed 32 or 16 slots at a time with AVX2 or
+ * SSE2 where the CPU supports them (detected at runtime), or one slot at a time otherwise. A lower instruction set can
+ * be forced (e.g. with the isa option of the benchmark mode), and crossCheck() compares all of them against
+ * GameboardModel (as the packcheck mode does on generated gameboards).
+ *
+ * It is used by the strategies that already work on packed gameboards (external BFS, pattern database construction,
+ * deadlock detection and post-optimization); the main searches, on deque-based gameboards, still use the scalar code
+ * of GameboardModel::isGameOver and GameboardModel::getAllMoves.
+ *
+ * An instance keeps its buffers between calls, so a single one should be reused for all boards with the same shape.
+ */
+class PackedBoard {
+public:
+    /**
+     * @brief Instruction set used by load().
+     */
+    enum Isa {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+private:
+    size_t nTubes;
+    size_t tubeH;
+    const uint8_t *board = nullptr;
+    std::vector<uint64_t> nonEmpty;     ///< @brief Bit k is set iff slot k is not empty.
+    std::vector<uint64_t> sameAbove;    ///< @brief Bit k is set iff slot k+1 holds the same byte as slot k.
+    std::vector<size_t> sizes;
+    std::vector<size_t> runs;           ///< @brief Number of contiguous, equal bytes at the bottom (empty slots included).
+    std::vector<uint64_t> topMask;      ///< @brief For each byte value, mask of tubes whose top holds it.
+    uint64_t emptyMask = 0;             ///< @brief Mask of empty tubes (only if there are at most 64 tubes).
+    uint64_t notFullMask = 0;           ///< @brief Mask of tubes that are not full (only if there are at most 64 tubes).
+
+    static Isa isa;
+public:
+    /**
+     * @brief Construct scanner for boards of a given shape.
+     *
+     * @param num_tubes     Number of tubes
+     * @param tube_height   Tube height, at most 64
+     */
+    PackedBoard(size_t num_tubes, size_t tube_height);
+
+    /**
+     * @brief Get instruction set in use.
+     */
+    static Isa getIsa();
+
+    /**
+     * @brief Set instruction set to use, if the CPU supports it.
+     *
+     * @return  Instruction set in use after the call
+     */
+    static Isa setIsa(Isa i);
+
+    /**
+     * @brief Check that every instruction set supported by the CPU gives the same results as GameboardModel.
+     *
+     * Compares the goal test, the valid moves, and the board after each move; the instruction set in use is restored.
+     *
+     * @param gameboard Gameboard, with tube height at most 64
+     * @return          True if all results match
+     */
+    static bool crossCheck(const GameboardModel &gameboard);
+
+    /**
+     * @brief Scan a packed board.
+     *
+     * @param p     Packed board, with nTubes × tubeH bytes, which must outlive all other calls until the next load()
+     */
+    void load(const uint8_t *p);
+
+    size_t size() const;                    ///< @brief Get number of tubes.
+    size_t tubeHeight() const;              ///< @brief Get tube height.
+    size_t getSize(size_t i) const;         ///< @brief Get number of pieces in tube i.
+    uint8_t getBottom(size_t i) const;      ///< @brief Get byte at the bottom of tube i (0 if empty).
+    uint8_t getTop(size_t i) const;         ///< @brief Get byte at the top of tube i (0 if empty).
+    size_t getBottomRun(size_t i) const;    ///< @brief Get number of contiguous, same-color pieces at the bottom of tube i.
+
+    /**
+     * @brief Check if game is over. @see GameboardModel::isGameOver
+     */
+    bool isGameOver() const;
+
+    /**
+     * @brief Get all valid moves, in the same order as GameboardModel::getAllMoves.
+     *
+     * @param out   Vector where the moves are written (previous contents are discarded)
+     */
+    void getAllMoves(std::vector<GameboardModel::Move> &out) const;
+
+    /**
+     * @brief Write the board loaded last, after a move, to another buffer.
+     *
+     * @param m     Valid move
+     * @param out   Destination, with nTubes × tubeH bytes
+     */
+    void move(const GameboardModel::Move &m, uint8_t *out) const;
+};
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <cwchar>
 #include <list>
+#include <string>
 #include <tuple>
 
 #include "TerminalGUIDrawable.h"
@@ -0,0 +1,105 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "BatchSolver.h"
+#include "CommandLineInterface.h"
+#include "model/BoardReader.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using hrc = chrono::high_resolution_clock;
+
+BatchSolver::BatchSolver(const vector<string> &arguments) {
+    size_t i = 0;
+    if(arguments.size() >= 2 && arguments[0] == "threads") {
+        nThreads = static_cast<size_t>(atol(arguments[1].c_str()));
+        i = 2;
+    }
+    if(nThreads == 0) nThreads = max(thread::hardware_concurrency(), 1u);
+    path = arguments.at(i++);
+    strategySpec.assign(arguments.begin() + static_cast<long>(i), arguments.end());
+    if(strategySpec.empty()) throw invalid_argument("missing strategy");
+}
+
+void BatchSolver::run() const {
+    BoardReader reader(path);
+    mutex readMutex, outputMutex;
+    size_t nextIndex = 0;
+
+    cout << "index,nTubes,tubeH,nColors,nMoves,t_ns,moves" << endl;
+
+    auto work = [&](){
+        map<string, unique_ptr<SearchStrategy> > built;
+        GameboardModel gameboard;
+        while(true) {
+            size_t index;
+            string row;
+            {
+                lock_guard<mutex> lock(readMutex);
+                index = nextIndex;
+                try {
+                    if(!reader.next(gameboard)) break;
+                    ++nextIndex;
+                } catch(const invalid_argument &e) {
+                    ++nextIndex;
+                    cerr << "Exception: board " << index << ": " << e.what() << endl;
+                    lock_guard<mutex> lockOutput(outputMutex);
+                    cout << index << ",,,,-1,," << endl;
+                    continue;
+                }
+            }
+            row = to_string(index) + "," + to_string(gameboard.size()) + "," + to_string(gameboard.tubeHeight()) + "," +
+                  to_string(gameboard.getNumberOfColors()) + ",";
+
+            try {
+                const string key = to_string(gameboard.size()) + " " + to_string(gameboard.tubeHeight()) + " " +
+                                   to_string(gameboard.getNumberOfColors());
+                auto it = built.find(key);
+                if(it == built.end()) {
+                    CommandLineInterface parser(strategySpec);
+                    parser.setBoard(gameboard);
+                    it = built.emplace(key, unique_ptr<SearchStrategy>(parser.parseStrategy())).first;
+                }
+                SearchStrategy *search = it->second.get();
+
+                // Strategies may search in next() as well (e.g. real-time search), so time covers the whole solution
+                vector<GameboardModel::Move> solution;
+                hrc::time_point begin = hrc::now();
+                search->initialize(gameboard);
+                GameboardModel g = gameboard;
+                while(!g.isGameOver()) {
+                    const GameboardModel::Move mv = search->next();
+                    if(!g.canMove(mv)) throw logic_error("invalid solution");
+                    g.move(mv);
+                    solution.push_back(mv);
+                }
+                hrc::time_point end = hrc::now();
+
+                string moves;
+                for(size_t i = 0; i < solution.size(); ++i)
+                    moves += (i > 0 ? " " : "") + to_string(solution[i].from) + ">" + to_string(solution[i].to);
+                row += to_string(solution.size()) + "," +
+                       to_string(chrono::duration_cast<chrono::nanoseconds>(end-begin).count()) + "," + moves;
+            } catch(const SearchStrategy::failed_to_find_solution &e) {
+                row += "-1,,";
+            } catch(const exception &e) {
+                cerr << "Exception: board " << index << ": " << e.what() << endl;
+                row += "-1,,";
+            }
+
+            lock_guard<mutex> lock(outputMutex);
+            cout << row << "\n";
+        }
+    };
+
+    vector<thread> threads;
+    for(size_t t = 0; t < nThreads; ++t) threads.emplace_back(work);
+    for(thread &t: threads) t.join();
+    cout << flush;
+}
@@ -0,0 +1,145 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "Benchmark.h"
+#include "CommandLineInterface.h"
+#include "model/PackedBoard.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <sched.h>
+#include <time.h>
+
+using namespace std;
+using hrc = chrono::steady_clock;
+
+Benchmark::Summary Benchmark::Summary::of(vector<double> samples) {
+    Summary ret;
+    if(samples.empty()) return ret;
+    sort(samples.begin(), samples.end());
+    const size_t n = samples.size();
+    ret.min    = samples.front();
+    ret.median = (n % 2 == 1 ? samples[n/2] : (samples[n/2 - 1] + samples[n/2]) / 2.0);
+    ret.p90    = samples[static_cast<size_t>(ceil(0.9 * static_cast<double>(n))) - 1];
+    for(const double &x: samples) ret.mean += x;
+    ret.mean /= static_cast<double>(n);
+    for(const double &x: samples) ret.stddev += (x - ret.mean) * (x - ret.mean);
+    ret.stddev = (n > 1 ? sqrt(ret.stddev / static_cast<double>(n - 1)) : 0.0);
+    return ret;
+}
+
+Benchmark::Benchmark(const vector<string> &arguments) {
+    deque<string> args(arguments.begin(), arguments.end());
+    while(!args.empty()) {
+        if     (args.at(0) == "warmup"  ){ args.pop_front(); nWarmup = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front(); }
+        else if(args.at(0) == "runs"    ){ args.pop_front(); nRuns   = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front(); }
+        else if(args.at(0) == "pin"     ){ args.pop_front(); cpu     = atoi(args.at(0).c_str()); args.pop_front(); }
+        else if(args.at(0) == "samples" ){ args.pop_front(); samplesPath = args.at(0); args.pop_front(); }
+        else if(args.at(0) == "isa"     ){ args.pop_front(); setIsa(args.at(0)); args.pop_front(); }
+        else if(args.at(0) == "noheader"){ args.pop_front(); header = false; }
+        else break;
+    }
+    if(nRuns == 0) throw invalid_argument("nRuns must be positive");
+
+    CommandLineInterface parser(vector<string>(args.begin(), args.end()));
+    gameboard = parser.parseBoard();
+    search.reset(parser.parseStrategy());
+    if(!parser.remaining().empty()) throw invalid_argument("unexpected arguments: " + parser.remaining());
+}
+
+void Benchmark::setIsa(const string &name) {
+    PackedBoard::Isa i;
+    if     (name == "scalar") i = PackedBoard::SCALAR;
+    else if(name == "sse2"  ) i = PackedBoard::SSE2;
+    else if(name == "avx2"  ) i = PackedBoard::AVX2;
+    else throw invalid_argument("unknown instruction set " + name);
+    if(PackedBoard::setIsa(i) != i) throw runtime_error("CPU does not support " + name);
+}
+
+chrono::nanoseconds Benchmark::cpuTime() {
+    timespec ts{};
+    if(clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) throw runtime_error("failed to get CPU time");
+    return chrono::seconds(ts.tv_sec) + chrono::nanoseconds(ts.tv_nsec);
+}
+
+void Benchmark::pin(int core) {
+    if(core < 0 || core >= CPU_SETSIZE) throw invalid_argument("invalid CPU " + to_string(core));
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if(sched_setaffinity(0, sizeof(set), &set) != 0) throw runtime_error("failed to pin to CPU " + to_string(core));
+}
+
+size_t Benchmark::play() {
+    search->initialize(gameboard);
+    GameboardModel g = gameboard;
+    size_t nMoves = 0;
+    while(!g.isGameOver()) {
+        const GameboardModel::Move m = search->next();
+        if(!g.canMove(m)) throw logic_error("strategy returned an invalid move");
+        g.move(m);
+        ++nMoves;
+    }
+    return nMoves;
+}
+
+void Benchmark::run() {
+    if(cpu >= 0) pin(cpu);
+
+    // Memory, and check of the solution; strategies may search in next() as well (e.g. real-time search)
+    cerr << "Measuring memory" << endl;
+    search->resetMemoryPeak();
+    const size_t nMoves = play();
+    const size_t mem = search->getMemory();
+
+    cerr << "Warming up (" << nWarmup << " runs)" << endl;
+    for(size_t i = 0; i < nWarmup; ++i) play();
+
+    cerr << "Measuring time (" << nRuns << " runs)" << endl;
+    vector<double> wallSamples(nRuns), cpuSamples(nRuns);
+    for(size_t i = 0; i < nRuns; ++i) {
+        const chrono::nanoseconds cpuBegin = cpuTime();
+        const hrc::time_point begin = hrc::now();
+        play();
+        const hrc::time_point end = hrc::now();
+        const chrono::nanoseconds cpuEnd = cpuTime();
+        wallSamples[i] = static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+        cpuSamples[i]  = static_cast<double>((cpuEnd - cpuBegin).count());
+    }
+    cerr << "Done" << endl;
+
+    if(!samplesPath.empty()) {
+        ofstream os(samplesPath);
+        if(!os) throw runtime_error("failed to open " + samplesPath);
+        os << "run,wall_ns,cpu_ns\n";
+        for(size_t i = 0; i < nRuns; ++i)
+            os << i << ","
+               << static_cast<unsigned long>(wallSamples[i]) << ","
+               << static_cast<unsigned long>(cpuSamples[i]) << "\n";
+        if(!os.flush()) throw runtime_error("failed to write " + samplesPath);
+    }
+
+    auto columns = [](const Summary &s) {
+        return to_string(llround(s.min))  + "," + to_string(llround(s.median)) + "," + to_string(llround(s.p90)) + "," +
+               to_string(llround(s.mean)) + "," + to_string(llround(s.stddev));
+    };
+    if(header)
+        cout << "nTubes,tubeH,nColors,seed,nMoves,mem_b,runs,"
+                "wall_min_ns,wall_median_ns,wall_p90_ns,wall_mean_ns,wall_stddev_ns,"
+                "cpu_min_ns,cpu_median_ns,cpu_p90_ns,cpu_mean_ns,cpu_stddev_ns" << endl;
+    cout << gameboard.size() << ","
+         << gameboard.tubeHeight() << ","
+         << gameboard.getNumberOfColors() << ","
+         << gameboard.getSeed() << ","
+         << nMoves << ","
+         << mem << ","
+         << nRuns << ","
+         << columns(Summary::of(wallSamples)) << ","
+         << columns(Summary::of(cpuSamples))
+         << endl;
+}
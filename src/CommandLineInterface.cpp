@@ -3,6 +3,7 @@
 
 #include "CommandLineInterface.h"
 
+#include <cctype>
 #include <iostream>
 #include <unistd.h>
 #include <algorithm/heuristics/NonAdmissibleHeuristic.h>
@@ -12,9 +13,20 @@
 #include "algorithm/DepthFirstGreedySearch.h"
 #include "algorithm/GreedySearch.h"
 #include "algorithm/AstarSearch.h"
+#include "algorithm/AnytimeAstarSearch.h"
+#include "algorithm/BeamSearch.h"
+#include "algorithm/RecursiveBestFirstSearch.h"
+#include "algorithm/RolloutSearch.h"
+#include "algorithm/RealTimeSearch.h"
+#include "algorithm/PostOptimizedSearch.h"
+#include "algorithm/CachedSearch.h"
 #include "algorithm/heuristics/AdmissibleHeuristic.h"
 #include "algorithm/heuristics/FiniteHorizonHeuristic.h"
+#include "algorithm/heuristics/PatternDatabaseHeuristic.h"
+#include "algorithm/visited/BitstateVisitedSet.h"
 #include "algorithm/BreadthFirstSearch.h"
+#include "algorithm/ExternalBreadthFirstSearch.h"
+#include "algorithm/FrontierBreadthFirstSearch.h"
 #include "model/GameboardModel.h"
 
 using namespace std;
@@ -37,49 +49,116 @@ void CommandLineInterface::run() {
 void CommandLineInterface::printHelp() const {
     cerr <<
          "Usage:\n"
-         "    main cli <nRuns> <BOARD> <STRATEGY>\n"
+         "    main cli [stats [json]] <nRuns> <BOARD> <STRATEGY>\n"
+         "    main bench [warmup <nRuns>] [runs <nRuns>] [pin <cpu>] [samples <file>] [isa scalar|sse2|avx2] [noheader] <BOARD> <STRATEGY>\n"
+         "    main sweep [threads <nThreads>] [runs <nRuns>] [noheader] <GRID> <alg> <STRATEGY> [-- <alg> <STRATEGY>...]\n"
+         "    main serve [workers <nWorkers>] [queue <capacity>] [<socketPath>]\n"
+         "    <REQUEST>  : [id <tag>] [budget <ms>] [memory <MB>] <BOARD> <STRATEGY>\n"
+         "    main batch [threads <nThreads>] <boardFile> <STRATEGY>\n"
+         "    main convert <boardFile> <outFile> [text|binary]\n"
+         "    main packcheck <count> <nTubes> <tubeH> <nColors> <seed>\n"
+         "    main generate [threads <nThreads>] <count> <nTubes> <tubeH> <nColors> <seed> [shuffle|scramble <depth>] [band <minMoves> <maxMoves>] <outFile> [text|binary] [<STRATEGY>]\n"
          "    <BOARD>    : <nTubes> <tubeH> <nColors> <seed>\n"
-         "    <STRATEGY> : [dfs|bfs|iterative-deepening]\n"
+         "    <BOARD>    : board <tubeH>:<tube>/<tube>/...   (pieces from bottom to top, colors 0-9a-zA-Z)\n"
+         "    <GRID>     : <RANGE:nTubes> <RANGE:tubeH> <RANGE:nColors> <RANGE:seed>\n"
+         "    <RANGE>    : <a>[:<b>[:<step>]][,<RANGE>]; bounds can be n, n-<k> or n/<k>, for n tubes\n"
+         "    <STRATEGY> : [bfs|frontier-bfs]\n"
+         "    <STRATEGY> : [dfs|iterative-deepening] [<VISITED>]\n"
+         "    <STRATEGY> : external-bfs <directory> <bufferStates>\n"
          "    <STRATEGY> : informed <INFORMED>\n"
-         "    <INFORMED> : <HEURISTIC> [dfs-greedy|greedy|astar]\n"
+         "    <STRATEGY> : optimize <window> <STRATEGY>\n"
+         "    <STRATEGY> : cache <file> <STRATEGY>\n"
+         "    <INFORMED> : <HEURISTIC> [greedy|astar|rbfs]\n"
+         "    <INFORMED> : <HEURISTIC> dfs-greedy [<VISITED>]\n"
+         "    <INFORMED> : <HEURISTIC> beam <width> <restarts>\n"
+         "    <INFORMED> : <HEURISTIC> anytime-astar <weight> <step> <deadline_ms>\n"
+         "    <INFORMED> : <HEURISTIC> rollout <nRollouts> <maxSteps> <temperature> <seed> <nThreads> <deadline_ms>\n"
+         "    <INFORMED> : <HEURISTIC> realtime <lookahead> <move_ms>\n"
          "    <HEURISTIC>: admissible\n"
          "    <HEURISTIC>: nonadmissible <factor>\n"
          "    <HEURISTIC>: finite-horizon-heuristics <FH>\n"
+         "    <HEURISTIC>: pdb <filePrefix> [max|additive] <pattern> [<pattern>...]\n"
+         "    <pattern>  : <color>[,<color>...]\n"
          "    <FH>       : <horizon> [admissible] [finite-horizon]\n"
+         "    <VISITED>  : bitstate <log2(bits)> <nHashes>\n"
          << flush;
 }
 
+GameboardModel CommandLineInterface::parseBoard() {
+    gameboard = board();
+    return gameboard;
+}
+
+void CommandLineInterface::setBoard(const GameboardModel &g) {
+    gameboard = g;
+}
+
+SearchStrategy *CommandLineInterface::parseStrategy() {
+    return strategy();
+}
+
+string CommandLineInterface::remaining() const {
+    string ret;
+    for(const string &s: args) ret += (ret.empty() ? "" : " ") + s;
+    return ret;
+}
+
 void CommandLineInterface::run_inside() {
+    bool stats = false, json = false;
+    if(args.at(0) == "stats") {
+        args.pop_front(); stats = true;
+        if(args.at(0) == "json"){ args.pop_front(); json = true; }
+    }
     size_t nRuns = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
 
-    GameboardModel gameboard = board();
+    gameboard = board();
     SearchStrategy *search = strategy();
 
     cerr << "Measuring memory" << endl;
-    size_t mem_prev = search->getMemory();
+    search->resetMemoryPeak();
+    search->resetStatistics(stats);
     try {
         search->initialize(gameboard);
     } catch(const exception &e){
         cout << "-1" << endl;
         return;
     }
-    size_t mem = search->getMemory() - mem_prev + 132000ul;
+    size_t mem = search->getMemory();
+    SearchStatistics statistics = search->getStatistics();
     cerr << "Measured memory" << endl;
+    if(bitstate != nullptr)
+        cerr << "Bitstate: " << bitstate->getNumberOfInsertions() << " states in " << bitstate->getMemory()
+             << " bytes, estimated omission probability " << bitstate->getOmissionProbability() << endl;
 
+    cerr << "Running " << nRuns << " times" << endl;
     hrc::time_point begin = hrc::now();
-    for(size_t i = 0; i < nRuns; ++i) {
-        cerr << "Running for the " << i << "th time" << endl;
-        search->initialize(gameboard);
-    }
+    for(size_t i = 0; i < nRuns; ++i) search->initialize(gameboard);
     hrc::time_point end = hrc::now();
     cerr << "Done running, checking if it is valid" << endl;
+    // Strategies that search while playing (e.g. real-time search) do so in next()
+    search->resetStatistics(stats);
     size_t nMoves = 0;
     while(!gameboard.isGameOver()){
         gameboard.move(search->next());
         ++nMoves;
     }
+    statistics += search->getStatistics();
     cerr << "Done" << endl;
     hrc::duration d = end-begin;
+    const unsigned long t = static_cast<unsigned long>(chrono::duration_cast<chrono::nanoseconds>(d).count()) / nRuns;
+    if(json) {
+        cout << "{"
+             << "\"nTubes\":"   << gameboard.size()              << ","
+             << "\"tubeH\":"    << gameboard.tubeHeight()        << ","
+             << "\"nColors\":"  << gameboard.getNumberOfColors() << ","
+             << "\"seed\":"     << gameboard.getSeed()           << ","
+             << "\"nMoves\":"   << nMoves                        << ","
+             << "\"memory\":"   << mem                           << ","
+             << "\"t_ns\":"     << t                             << ","
+             << "\"stats\":"    << statistics.toJson(nMoves)
+             << "}" << endl;
+        return;
+    }
     cout
         << gameboard.size() << ","
         << gameboard.tubeHeight() << ","
@@ -87,11 +166,19 @@ void CommandLineInterface::run_inside() {
         << gameboard.getSeed() << ","
         << nMoves << ","
         << mem << ","
-        << static_cast<unsigned long>(chrono::duration_cast<chrono::nanoseconds>(d).count()) / nRuns
-    << endl;
+        << t;
+    if(stats) cout << "," << statistics.toCsv(nMoves);
+    cout << endl;
 }
 
 GameboardModel CommandLineInterface::board() {
+    if(args.at(0) == "board") {
+        args.pop_front();
+        GameboardModel ret;
+        ret.fromText(args.at(0)); args.pop_front();
+        return ret;
+    }
+
     size_t nTubes, tubeH, nColors;
     unsigned seed;
 
@@ -108,27 +195,93 @@ GameboardModel CommandLineInterface::board() {
 
 SearchStrategy *CommandLineInterface::strategy() {
     string method = args.at(0); args.pop_front();
-    if     (method == "dfs"                ) return new DepthFirstSearch        ();
+    if     (method == "dfs"                ) return new DepthFirstSearch        (visitedSet());
     else if(method == "bfs"                ) return new BreadthFirstSearch      ();
-    else if(method == "iterative-deepening") return new IterativeDeepeningSearch();
+    else if(method == "frontier-bfs"       ) return new FrontierBreadthFirstSearch();
+    else if(method == "iterative-deepening") return new IterativeDeepeningSearch(visitedSet());
+    else if(method == "external-bfs"       ) return externalBreadthFirstSearch();
     else if(method == "informed"           ) return informed();
+    else if(method == "optimize"           ) return postOptimizedSearch();
+    else if(method == "cache"              ) return cachedSearch();
     else throw invalid_argument("");
 }
 
+SearchStrategy *CommandLineInterface::externalBreadthFirstSearch() {
+    string directory = args.at(0); args.pop_front();
+    size_t buffer = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
+    return new ExternalBreadthFirstSearch(directory, buffer);
+}
+
+SearchStrategy *CommandLineInterface::postOptimizedSearch() {
+    size_t window = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
+    return new PostOptimizedSearch(strategy(), window);
+}
+
+SearchStrategy *CommandLineInterface::cachedSearch() {
+    string path = args.at(0); args.pop_front();
+    shared_ptr<SolutionCache> cache = SolutionCache::open(path);
+    return new CachedSearch(strategy(), cache);
+}
+
 SearchStrategy *CommandLineInterface::informed() {
     Heuristic *h = heuristic();
     string method = args.at(0); args.pop_front();
-    if     (method == "dfs-greedy") return new DepthFirstGreedySearch(h);
+    if     (method == "dfs-greedy") return new DepthFirstGreedySearch(h, visitedSet());
     else if(method == "greedy"    ) return new GreedySearch          (h);
     else if(method == "astar"     ) return new AstarSearch           (h);
+    else if(method == "rbfs"      ) return new RecursiveBestFirstSearch(h);
+    else if(method == "beam"      ) return beamSearch(h);
+    else if(method == "anytime-astar") return anytimeAstarSearch(h);
+    else if(method == "rollout"   ) return rolloutSearch(h);
+    else if(method == "realtime"  ) return realTimeSearch(h);
     else throw invalid_argument("");
 }
 
+SearchStrategy *CommandLineInterface::beamSearch(Heuristic *h) {
+    size_t width    = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
+    size_t restarts = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
+    return new BeamSearch(h, width, restarts);
+}
+
+SearchStrategy *CommandLineInterface::anytimeAstarSearch(Heuristic *h) {
+    double weight   = atof(args.at(0).c_str()); args.pop_front();
+    double step     = atof(args.at(0).c_str()); args.pop_front();
+    long deadlineMs = atol(args.at(0).c_str()); args.pop_front();
+    return new AnytimeAstarSearch(h, weight, step, deadlineMs);
+}
+
+SearchStrategy *CommandLineInterface::rolloutSearch(Heuristic *h) {
+    size_t rollouts = static_cast<size_t  >(atol(args.at(0).c_str())); args.pop_front();
+    size_t steps    = static_cast<size_t  >(atol(args.at(0).c_str())); args.pop_front();
+    double T        = atof(args.at(0).c_str()); args.pop_front();
+    unsigned seed   = static_cast<unsigned>(atol(args.at(0).c_str())); args.pop_front();
+    size_t threads  = static_cast<size_t  >(atol(args.at(0).c_str())); args.pop_front();
+    long deadlineMs = atol(args.at(0).c_str()); args.pop_front();
+    return new RolloutSearch(h, rollouts, steps, T, seed, threads, deadlineMs);
+}
+
+SearchStrategy *CommandLineInterface::realTimeSearch(Heuristic *h) {
+    size_t lookahead = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
+    long moveMs      = atol(args.at(0).c_str()); args.pop_front();
+    return new RealTimeSearch(h, lookahead, moveMs);
+}
+
+VisitedSet *CommandLineInterface::visitedSet() {
+    if(args.empty() || args.at(0) != "bitstate") return nullptr;
+    args.pop_front();
+    size_t log2Bits = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
+    size_t nHashes  = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front();
+    BitstateVisitedSet *ret = new BitstateVisitedSet(log2Bits, nHashes);
+    bitstate = ret;
+    return ret;
+}
+
 Heuristic *CommandLineInterface::heuristic() {
     string s = args.at(0); args.pop_front();
     if     (s == "admissible"               ) return new AdmissibleHeuristic();
     else if(s == "nonadmissible"            ) return nonAdmissibleHeuristic();
     else if(s == "finite-horizon-heuristics") return finiteHorizonHeuristic();
+    else if(s == "pdb"                      ) return patternDatabaseHeuristic();
     else throw invalid_argument("");
 }
 
@@ -149,3 +302,29 @@ Heuristic *CommandLineInterface::finiteHorizonHeuristic() {
     else throw invalid_argument("");
     return fhStrategy;
 }
+
+Heuristic *CommandLineInterface::patternDatabaseHeuristic() {
+    string prefix = args.at(0); args.pop_front();
+    string mode   = args.at(0); args.pop_front();
+    bool additive;
+    if     (mode == "max"     ) additive = false;
+    else if(mode == "additive") additive = true;
+    else throw invalid_argument("");
+
+    vector< shared_ptr<const PatternDatabase> > dbs;
+    while(!args.empty() && isdigit(static_cast<unsigned char>(args.at(0)[0]))) {
+        string s = args.at(0); args.pop_front();
+        vector<color_t> pattern;
+        string path = prefix + "-" + to_string(gameboard.size()) + "x" + to_string(gameboard.tubeHeight()) + "-" +
+                      to_string(gameboard.getNumberOfColors()) + "-";
+        for(size_t i = 0, j; i < s.size(); i = j+1) {
+            j = min(s.find(',', i), s.size());
+            pattern.push_back(static_cast<color_t>(atol(s.substr(i, j-i).c_str())));
+            path += (i == 0 ? "" : "_") + to_string(pattern.back());
+        }
+        path += (additive ? "-add.pdb" : "-max.pdb");
+        dbs.push_back(PatternDatabase::open(path, gameboard.size(), gameboard.tubeHeight(),
+                                            gameboard.getNumberOfColors(), pattern, additive));
+    }
+    return new PatternDatabaseHeuristic(dbs);
+}
@@ -0,0 +1,200 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "DatasetGenerator.h"
+#include "CommandLineInterface.h"
+#include "model/BoardGenerator.h"
+#include "model/BoardWriter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+using hrc = chrono::high_resolution_clock;
+
+namespace {
+    /**
+     * @brief Number of gameboards generated before writing them.
+     */
+    const size_t CHUNK = 1 << 14;
+
+    /**
+     * @brief Maximum number of candidates per gameboard requested, before giving up on a difficulty band.
+     */
+    const size_t MAX_CANDIDATES_PER_BOARD = 1000;
+}
+
+DatasetGenerator::DatasetGenerator(const vector<string> &arguments) {
+    size_t i = 0;
+    if(arguments.size() >= 2 && arguments[0] == "threads") {
+        nThreads = static_cast<size_t>(atol(arguments[1].c_str()));
+        i = 2;
+    }
+    if(nThreads == 0) nThreads = max(thread::hardware_concurrency(), 1u);
+    count   = static_cast<size_t>(atol(arguments.at(i++).c_str()));
+    nTubes  = static_cast<size_t>(atol(arguments.at(i++).c_str()));
+    tubeH   = static_cast<size_t>(atol(arguments.at(i++).c_str()));
+    nColors = static_cast<size_t>(atol(arguments.at(i++).c_str()));
+    seed    = strtoull(arguments.at(i++).c_str(), nullptr, 10);
+    if(arguments.at(i) == "shuffle") {
+        ++i;
+    } else if(arguments.at(i) == "scramble") {
+        scramble = true;
+        depth = static_cast<size_t>(atol(arguments.at(i+1).c_str()));
+        i += 2;
+    }
+    if(arguments.at(i) == "band") {
+        band = true;
+        minMoves = static_cast<size_t>(atol(arguments.at(i+1).c_str()));
+        maxMoves = static_cast<size_t>(atol(arguments.at(i+2).c_str()));
+        i += 3;
+        if(minMoves > maxMoves) throw invalid_argument("empty band");
+    }
+    path = arguments.at(i++);
+    if(i < arguments.size() && (arguments[i] == "text" || arguments[i] == "binary")) {
+        format = (arguments[i] == "text" ? BoardReader::TEXT : BoardReader::BINARY);
+        ++i;
+    }
+    strategySpec.assign(arguments.begin() + static_cast<long>(i), arguments.end());
+    if(!strategySpec.empty() && !band) throw invalid_argument("unexpected argument " + strategySpec[0]);
+    if(strategySpec.empty()) strategySpec = {"informed", "admissible", "astar"};
+
+    // Fail before creating the output file
+    const GameboardModel sample = BoardGenerator(0).shuffled(nTubes, tubeH, nColors);
+    if(band) {
+        CommandLineInterface parser(strategySpec);
+        parser.setBoard(sample);
+        delete parser.parseStrategy();
+    }
+}
+
+GameboardModel DatasetGenerator::generate(uint64_t i) const {
+    BoardGenerator generator(BoardGenerator::seedOf(seed, i));
+    return (scramble ? generator.scrambled(nTubes, tubeH, nColors, depth)
+                     : generator.shuffled (nTubes, tubeH, nColors));
+}
+
+void DatasetGenerator::run() const {
+    if(band) { runBand(); return; }
+
+    BoardWriter writer(path, format);
+    vector<GameboardModel> chunk;
+    for(size_t begin = 0; begin < count; begin += CHUNK) {
+        const size_t n = min(CHUNK, count - begin);
+        chunk.assign(n, GameboardModel());
+
+        vector<thread> threads;
+        for(size_t t = 0; t < min(nThreads, n); ++t) {
+            threads.emplace_back([this, &chunk, begin, n, t](){
+                for(size_t j = t; j < n; j += nThreads) chunk[j] = generate(begin + j);
+            });
+        }
+        for(thread &t: threads) t.join();
+
+        for(const GameboardModel &g: chunk) writer.write(g);
+    }
+    writer.close();
+}
+
+void DatasetGenerator::runBand() const {
+    /**
+     * @brief Measurement of a candidate; nMoves is -1 if it could not be solved.
+     */
+    struct Candidate {
+        GameboardModel gameboard;
+        long nMoves = -1;
+        long long t_ns = 0;
+        string moves;
+    };
+
+    BoardWriter writer(path, format);
+    const string labelsPath = (path == "-" ? "" : path + ".csv");
+    ofstream labelsFile;
+    if(!labelsPath.empty()) {
+        labelsFile.open(labelsPath);
+        if(!labelsFile) throw runtime_error("failed to open " + labelsPath);
+    }
+    ostream &labels = (labelsPath.empty() ? cerr : labelsFile);
+    labels << "index,nTubes,tubeH,nColors,nMoves,t_ns,moves" << endl;
+
+    // One strategy per thread, kept between chunks
+    vector< unique_ptr<SearchStrategy> > strategies(nThreads);
+
+    const size_t chunkSize = max<size_t>(64, 8*nThreads);
+    const size_t maxCandidates = max(count * MAX_CANDIDATES_PER_BOARD, chunkSize);
+    vector<Candidate> chunk;
+    size_t accepted = 0, candidates = 0;
+    while(accepted < count) {
+        if(candidates >= maxCandidates)
+            throw runtime_error("only " + to_string(accepted) + " of " + to_string(candidates) +
+                                " candidates were in the band");
+        chunk.assign(chunkSize, Candidate());
+        atomic<size_t> next(0);
+        exception_ptr error;
+        mutex errorMutex;
+
+        auto work = [this, &chunk, &next, &strategies, &error, &errorMutex, candidates](size_t t){
+            for(size_t j = next++; j < chunk.size(); j = next++) {
+                Candidate &c = chunk[j];
+                c.gameboard = generate(candidates + j);
+                try {
+                    if(strategies[t] == nullptr) {
+                        CommandLineInterface parser(strategySpec);
+                        parser.setBoard(c.gameboard);
+                        strategies[t].reset(parser.parseStrategy());
+                    }
+                    SearchStrategy *search = strategies[t].get();
+
+                    // Strategies may search in next() as well (e.g. real-time search), so time covers the whole solution
+                    vector<GameboardModel::Move> solution;
+                    hrc::time_point begin = hrc::now();
+                    search->initialize(c.gameboard);
+                    GameboardModel g = c.gameboard;
+                    while(!g.isGameOver()) {
+                        const GameboardModel::Move mv = search->next();
+                        if(!g.canMove(mv)) throw logic_error("invalid solution");
+                        g.move(mv);
+                        solution.push_back(mv);
+                    }
+                    hrc::time_point end = hrc::now();
+
+                    for(size_t i = 0; i < solution.size(); ++i)
+                        c.moves += (i > 0 ? " " : "") + to_string(solution[i].from) + ">" + to_string(solution[i].to);
+                    c.nMoves = static_cast<long>(solution.size());
+                    c.t_ns = chrono::duration_cast<chrono::nanoseconds>(end-begin).count();
+                } catch(const SearchStrategy::failed_to_find_solution &e) {
+                    c.nMoves = -1;
+                } catch(const exception &e) {
+                    lock_guard<mutex> lock(errorMutex);
+                    if(error == nullptr) error = current_exception();
+                    next = chunk.size();
+                }
+            }
+        };
+        vector<thread> threads;
+        for(size_t t = 0; t < nThreads; ++t) threads.emplace_back(work, t);
+        for(thread &t: threads) t.join();
+        if(error != nullptr) rethrow_exception(error);
+
+        for(const Candidate &c: chunk) {
+            if(accepted >= count) break;
+            if(c.nMoves < 0 || size_t(c.nMoves) < minMoves || size_t(c.nMoves) > maxMoves) continue;
+            writer.write(c.gameboard);
+            labels << accepted << "," << c.gameboard.size() << "," << c.gameboard.tubeHeight() << ","
+                   << c.gameboard.getNumberOfColors() << "," << c.nMoves << "," << c.t_ns << "," << c.moves << "\n";
+            ++accepted;
+        }
+        candidates += chunkSize;
+    }
+    writer.close();
+    if(!labels.flush()) throw runtime_error("failed to write " + (labelsPath.empty() ? string("measurements") : labelsPath));
+}
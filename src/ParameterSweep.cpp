@@ -0,0 +1,160 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "ParameterSweep.h"
+#include "CommandLineInterface.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using hrc = chrono::high_resolution_clock;
+
+ParameterSweep::ParameterSweep(const vector<string> &arguments) {
+    deque<string> args(arguments.begin(), arguments.end());
+    while(!args.empty()) {
+        if     (args.at(0) == "threads"){ args.pop_front(); nThreads = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front(); }
+        else if(args.at(0) == "runs"   ){ args.pop_front(); nRuns    = static_cast<size_t>(atol(args.at(0).c_str())); args.pop_front(); }
+        else if(args.at(0) == "noheader"){ args.pop_front(); header = false; }
+        else break;
+    }
+    if(nThreads == 0) nThreads = max(thread::hardware_concurrency(), 1u);
+    if(nRuns == 0) throw invalid_argument("nRuns must be positive");
+
+    const string tubesSpec  = args.at(0); args.pop_front();
+    const string heightSpec = args.at(0); args.pop_front();
+    const string colorsSpec = args.at(0); args.pop_front();
+    const string seedsSpec  = args.at(0); args.pop_front();
+
+    while(!args.empty()) {
+        Strategy s;
+        s.alg = args.at(0); args.pop_front();
+        while(!args.empty() && args.at(0) != "--"){ s.spec.push_back(args.at(0)); args.pop_front(); }
+        if(!args.empty()) args.pop_front();
+        if(s.spec.empty()) throw invalid_argument("missing strategy for " + s.alg);
+        strategies.push_back(s);
+    }
+    if(strategies.empty()) throw invalid_argument("no strategies");
+
+    for(size_t i = 0; i < strategies.size(); ++i)
+        for(size_t nTubes: expand(tubesSpec, 0))
+            for(size_t tubeH: expand(heightSpec, nTubes))
+                for(size_t nColors: expand(colorsSpec, nTubes))
+                    for(size_t seed: expand(seedsSpec, nTubes))
+                        if(nColors >= 1 && nColors <= nTubes && tubeH >= 1)
+                            tasks.push_back(Task{i, nTubes, tubeH, nColors, static_cast<unsigned>(seed)});
+
+    // Larger boards first; within the same size, in the order of the grid
+    stable_sort(tasks.begin(), tasks.end(), [](const Task &a, const Task &b){
+        return a.nTubes*a.tubeH > b.nTubes*b.tubeH;
+    });
+}
+
+vector<size_t> ParameterSweep::expand(const string &spec, size_t nTubes) {
+    auto value = [nTubes](const string &s) -> size_t {
+        if(s.empty()) throw invalid_argument("empty range bound");
+        if(s[0] != 'n') return static_cast<size_t>(atol(s.c_str()));
+        if(s.size() == 1) return nTubes;
+        const size_t k = static_cast<size_t>(atol(s.c_str() + 2));
+        if(s[1] == '-') return (k <= nTubes ? nTubes - k : 0);
+        if(s[1] == '/' && k > 0) return nTubes / k;
+        throw invalid_argument("invalid range bound " + s);
+    };
+
+    vector<size_t> ret;
+    istringstream is(spec);
+    string item;
+    while(getline(is, item, ',')) {
+        vector<string> parts;
+        istringstream is2(item);
+        string part;
+        while(getline(is2, part, ':')) parts.push_back(part);
+        if(parts.empty() || parts.size() > 3) throw invalid_argument("invalid range " + spec);
+        const size_t a    = value(parts[0]);
+        const size_t b    = (parts.size() >= 2 ? value(parts[1]) : a);
+        const size_t step = (parts.size() >= 3 ? value(parts[2]) : 1);
+        if(step == 0) throw invalid_argument("invalid range " + spec);
+        for(size_t x = a; x <= b; x += step) ret.push_back(x);
+    }
+    return ret;
+}
+
+string ParameterSweep::run(const Task &task, map<string, unique_ptr<SearchStrategy> > &built) const {
+    const Strategy &strategy = strategies.at(task.strategy);
+    string row = strategy.alg + " ," +
+        to_string(task.nTubes) + "," + to_string(task.tubeH) + "," + to_string(task.nColors) + "," +
+        to_string(task.seed) + ",";
+
+    vector<string> args = {to_string(task.nTubes), to_string(task.tubeH), to_string(task.nColors), to_string(task.seed)};
+    args.insert(args.end(), strategy.spec.begin(), strategy.spec.end());
+    CommandLineInterface parser(args);
+    GameboardModel gameboard;
+    SearchStrategy *search;
+    try {
+        gameboard = parser.parseBoard();
+        const string key = to_string(task.strategy) + " " + to_string(task.nTubes) + " " + to_string(task.tubeH) + " " +
+                           to_string(task.nColors);
+        auto it = built.find(key);
+        if(it == built.end()) it = built.emplace(key, unique_ptr<SearchStrategy>(parser.parseStrategy())).first;
+        search = it->second.get();
+    } catch(const exception &e) {
+        cerr << "Exception: " << strategy.alg << ": " << e.what() << endl;
+        return row + "-1,-1,-1";
+    }
+
+    // Strategies may search in next() as well (e.g. real-time search), so each run plays until the game is over
+    auto play = [search, &gameboard]() -> size_t {
+        search->initialize(gameboard);
+        GameboardModel g = gameboard;
+        size_t nMoves = 0;
+        while(!g.isGameOver()) {
+            const GameboardModel::Move mv = search->next();
+            if(!g.canMove(mv)) throw logic_error("invalid solution");
+            g.move(mv);
+            ++nMoves;
+        }
+        return nMoves;
+    };
+
+    size_t nMoves, mem;
+    hrc::duration d{};
+    try {
+        search->resetMemoryPeak();
+        nMoves = play();
+        mem = search->getMemory();
+
+        hrc::time_point begin = hrc::now();
+        for(size_t i = 0; i < nRuns; ++i) play();
+        d = hrc::now() - begin;
+    } catch(const exception &e) {
+        return row + "-1,-1,-1";
+    }
+
+    return row + to_string(nMoves) + "," + to_string(mem) + "," +
+        to_string(static_cast<unsigned long>(chrono::duration_cast<chrono::nanoseconds>(d).count()) / nRuns);
+}
+
+void ParameterSweep::run() const {
+    if(header) cout << "alg,nTubes,tubeH,nColors,seed,nMoves,mem_b,t_ns" << endl;
+
+    atomic<size_t> next{0};
+    mutex outputMutex;
+    vector<thread> threads;
+    for(size_t t = 0; t < min(nThreads, max<size_t>(tasks.size(), 1)); ++t) {
+        threads.emplace_back([this, &next, &outputMutex](){
+            map<string, unique_ptr<SearchStrategy> > built;
+            for(size_t i = next++; i < tasks.size(); i = next++) {
+                const string row = run(tasks[i], built);
+                lock_guard<mutex> lock(outputMutex);
+                cout << row << endl;
+            }
+        });
+    }
+    for(thread &t: threads) t.join();
+}
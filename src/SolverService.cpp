@@ -0,0 +1,297 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "SolverService.h"
+#include "CommandLineInterface.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using hrc = chrono::high_resolution_clock;
+
+namespace {
+    /**
+     * @brief Get resident memory of this process, in bytes.
+     */
+    size_t residentMemory() {
+        FILE *f = fopen("/proc/self/statm", "r");
+        if(f == nullptr) return 0;
+        unsigned long size = 0, resident = 0;
+        if(fscanf(f, "%lu %lu", &size, &resident) != 2) resident = 0;
+        fclose(f);
+        return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+}
+
+/**
+ * @brief Source of requests and destination of their replies.
+ */
+struct SolverService::Connection {
+    int in;
+    int out;
+    std::mutex mtx;
+    std::condition_variable answered;
+    size_t pending = 0;     ///< @brief Number of requests queued and not yet answered.
+
+    Connection(int inFd, int outFd): in(inFd), out(outFd) {}
+
+    void reply(const std::string &id, const std::string &line) {
+        const std::string s = (id.empty() ? "" : id + " ") + line + "\n";
+        std::lock_guard<std::mutex> lock(mtx);
+        for(size_t written = 0; written < s.size(); ) {
+            const ssize_t n = write(out, s.data() + written, s.size() - written);
+            if(n <= 0) break;
+            written += static_cast<size_t>(n);
+        }
+    }
+};
+
+/**
+ * @brief Request waiting to be solved.
+ */
+struct SolverService::Job {
+    size_t sequence;
+    size_t cost;                        ///< @brief Estimate of how long it takes to solve.
+    std::string id;
+    bool hasDeadline = false;
+    clock::time_point deadline;
+    size_t memoryBudget = 0;            ///< @brief In bytes, or 0 if there is none.
+    std::unique_ptr<CommandLineInterface> parser;
+    GameboardModel gameboard;
+    std::string key;                    ///< @brief Board shape and strategy specification.
+    std::shared_ptr<Connection> connection;
+};
+
+bool SolverService::JobOrder::operator()(const shared_ptr<Job> &a, const shared_ptr<Job> &b) const {
+    if(a->cost != b->cost) return a->cost > b->cost;
+    return a->sequence > b->sequence;
+}
+
+SolverService::SolverService(size_t nWorkers, size_t capacity):
+    queueCapacity(max<size_t>(capacity, 1))
+{
+    for(size_t i = 0; i < max<size_t>(nWorkers, 1); ++i) workers.emplace_back(&SolverService::work, this);
+}
+
+void SolverService::submit(const shared_ptr<Connection> &connection, const string &request) {
+    shared_ptr<Job> job = make_shared<Job>();
+    job->connection = connection;
+    try {
+        vector<string> tokens;
+        {
+            istringstream is(request);
+            string s;
+            while(is >> s) tokens.push_back(s);
+        }
+        size_t i = 0;
+        for(; i+1 < tokens.size(); i += 2) {
+            if     (tokens[i] == "id"    ) job->id = tokens[i+1];
+            else if(tokens[i] == "budget"){ job->hasDeadline = true;
+                                            job->deadline = clock::now() + chrono::milliseconds(atol(tokens[i+1].c_str())); }
+            else if(tokens[i] == "memory") job->memoryBudget = static_cast<size_t>(atol(tokens[i+1].c_str())) << 20;
+            else break;
+        }
+        tokens.erase(tokens.begin(), tokens.begin() + static_cast<long>(i));
+
+        job->parser.reset(new CommandLineInterface(tokens));
+        job->gameboard = job->parser->parseBoard();
+        job->cost = job->gameboard.size() * job->gameboard.tubeHeight();
+        job->key = to_string(job->gameboard.size()) + " " + to_string(job->gameboard.tubeHeight()) + " " +
+                   to_string(job->gameboard.getNumberOfColors()) + " " + job->parser->remaining();
+    } catch(const out_of_range &e) {
+        connection->reply(job->id, "error incomplete request");
+        return;
+    } catch(const exception &e) {
+        connection->reply(job->id, string("error ") + (e.what()[0] != '\0' ? e.what() : "invalid request"));
+        return;
+    }
+
+    { lock_guard<mutex> lock(connection->mtx); ++connection->pending; }
+    unique_lock<mutex> lock(m);
+    notFull.wait(lock, [this](){ return queue.size() < queueCapacity; });
+    job->sequence = nextSequence++;
+    queue.push(job);
+    notEmpty.notify_one();
+}
+
+void SolverService::work() {
+    while(true) {
+        shared_ptr<Job> job;
+        {
+            unique_lock<mutex> lock(m);
+            notEmpty.wait(lock, [this](){ return stopping || !queue.empty(); });
+            if(queue.empty()) return;
+            job = queue.top();
+            queue.pop();
+            notFull.notify_one();
+        }
+        const string reply = solve(*job);
+        job->connection->reply(job->id, reply);
+        {
+            lock_guard<mutex> lock(job->connection->mtx);
+            --job->connection->pending;
+        }
+        job->connection->answered.notify_all();
+    }
+}
+
+string SolverService::solve(Job &job) {
+    if(job.hasDeadline && clock::now() >= job.deadline) return "-1";
+
+    // Reuse a strategy built by a previous request, if one is idle
+    unique_ptr<SearchStrategy> search;
+    {
+        lock_guard<mutex> lock(strategiesMutex);
+        auto it = idleStrategies.find(job.key);
+        if(it != idleStrategies.end()) {
+            search = move(it->second);
+            idleStrategies.erase(it);
+        }
+    }
+    if(search == nullptr) {
+        try {
+            search.reset(job.parser->parseStrategy());
+        } catch(const out_of_range &e) {
+            return "error incomplete request";
+        } catch(const exception &e) {
+            return string("error ") + (e.what()[0] != '\0' ? e.what() : "invalid request");
+        }
+    }
+
+    // Cancel the search if it misses the deadline or exceeds the memory budget
+    mutex wm;
+    condition_variable cv;
+    bool done = false;
+    thread watchdog;
+    search->resetCancel();
+    if(job.hasDeadline || job.memoryBudget > 0) {
+        const size_t memoryLimit = residentMemory() + job.memoryBudget;
+        watchdog = thread([&job, &wm, &cv, &done, &search, memoryLimit](){
+            unique_lock<mutex> lock(wm);
+            while(!done) {
+                clock::time_point wake = (job.memoryBudget > 0 ? clock::now() + chrono::milliseconds(10) : job.deadline);
+                if(job.hasDeadline) wake = min(wake, job.deadline);
+                if(cv.wait_until(lock, wake, [&done](){ return done; })) break;
+                if((job.hasDeadline && clock::now() >= job.deadline) ||
+                   (job.memoryBudget > 0 && residentMemory() > memoryLimit)) {
+                    search->cancel();
+                    break;
+                }
+            }
+        });
+    }
+    auto stopWatchdog = [&](){
+        { lock_guard<mutex> lock(wm); done = true; }
+        cv.notify_all();
+        if(watchdog.joinable()) watchdog.join();
+    };
+
+    string ret;
+    search->resetMemoryPeak();
+    try {
+        // Strategies may search in next() as well (e.g. real-time search), so limits and time cover the whole solution
+        hrc::time_point begin = hrc::now();
+        search->initialize(job.gameboard);
+        size_t nMoves = 0;
+        GameboardModel g = job.gameboard;
+        while(!g.isGameOver()) {
+            const GameboardModel::Move mv = search->next();
+            if(!g.canMove(mv)) throw logic_error("invalid solution");
+            g.move(mv);
+            ++nMoves;
+        }
+        hrc::time_point end = hrc::now();
+        stopWatchdog();
+        size_t mem = search->getMemory();
+
+        ret =
+            to_string(job.gameboard.size()) + "," +
+            to_string(job.gameboard.tubeHeight()) + "," +
+            to_string(job.gameboard.getNumberOfColors()) + "," +
+            to_string(job.gameboard.getSeed()) + "," +
+            to_string(nMoves) + "," +
+            to_string(mem) + "," +
+            to_string(chrono::duration_cast<chrono::nanoseconds>(end-begin).count());
+    } catch(const SearchStrategy::failed_to_find_solution &e) {
+        stopWatchdog();
+        ret = "-1";
+    } catch(const exception &e) {
+        stopWatchdog();
+        ret = string("error ") + e.what();
+    }
+
+    // Keep strategy for later requests
+    search->resetCancel();
+    lock_guard<mutex> lock(strategiesMutex);
+    if(idleStrategies.size() < MAX_IDLE_STRATEGIES) idleStrategies.emplace(job.key, move(search));
+    return ret;
+}
+
+void SolverService::session(const shared_ptr<Connection> &connection) {
+    string buffer;
+    char chunk[4096];
+    bool eof = false;
+    while(!eof) {
+        const ssize_t n = read(connection->in, chunk, sizeof(chunk));
+        if(n <= 0){ eof = true; buffer += '\n'; }
+        else buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t pos;
+        while((pos = buffer.find('\n')) != string::npos) {
+            const string line = buffer.substr(0, pos);
+            buffer.erase(0, pos+1);
+            if(line.find_first_not_of(" \t\r") != string::npos) submit(connection, line);
+        }
+    }
+    unique_lock<mutex> lock(connection->mtx);
+    connection->answered.wait(lock, [&connection](){ return connection->pending == 0; });
+}
+
+void SolverService::serveStdin() {
+    session(make_shared<Connection>(STDIN_FILENO, STDOUT_FILENO));
+}
+
+void SolverService::serveSocket(const string &path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(addr.sun_path)) throw invalid_argument("socket path is too long");
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0) throw runtime_error("failed to create socket");
+    struct stat st{};
+    if(stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path.c_str());
+    // A client that disconnects before reading its reply must not terminate the service
+    signal(SIGPIPE, SIG_IGN);
+    if(bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        throw runtime_error("failed to listen on " + path);
+    }
+    cerr << "Listening on " << path << " with " << workers.size() << " workers" << endl;
+    while(true) {
+        int conn = accept(fd, nullptr, nullptr);
+        if(conn < 0) continue;
+        thread([this, conn](){
+            session(make_shared<Connection>(conn, conn));
+            close(conn);
+        }).detach();
+    }
+}
+
+SolverService::~SolverService() {
+    {
+        lock_guard<mutex> lock(m);
+        stopping = true;
+    }
+    notEmpty.notify_all();
+    for(thread &t: workers) t.join();
+}
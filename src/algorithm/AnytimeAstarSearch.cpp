@@ -0,0 +1,165 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/AnytimeAstarSearch.h"
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+
+using namespace std;
+using Move = GameboardModel::Move;
+using hrc = chrono::steady_clock;
+
+namespace {
+    /**
+     * @brief Information kept for each generated state.
+     */
+    struct Info {
+        size_t g;       ///< @brief Length of the best known path from the initial state.
+        double h;       ///< @brief Heuristic value (cached, as it is needed again whenever the weight changes).
+        Move prev;      ///< @brief Last move of the best known path.
+    };
+
+    typedef tuple<double, size_t, GameboardModel> Entry;
+    typedef priority_queue<Entry, CountedVector<Entry>, greater<> > Queue;
+}
+
+AnytimeAstarSearch::AnytimeAstarSearch(const Heuristic *heuristic, double weight, double step, long deadlineMs):
+    h(heuristic),
+    initialWeight(max(weight, 1.0)),
+    weightStep(step),
+    deadline(deadlineMs)
+{
+}
+
+void AnytimeAstarSearch::setImprovementCallback(const function<void(const Improvement &)> &f) {
+    callback = f;
+}
+
+const vector<AnytimeAstarSearch::Improvement> &AnytimeAstarSearch::getImprovements() const {
+    return improvements;
+}
+
+void AnytimeAstarSearch::initialize(const GameboardModel &src) {
+    checkSolvable(src, "AnytimeAstarSearch");
+    const hrc::time_point begin = hrc::now();
+    auto expired = [this, &begin](){
+        return deadline.count() > 0 && hrc::now() - begin >= deadline;
+    };
+
+    improvements.clear();
+    solution.clear();
+
+    CountedMap<GameboardModel, Info> info(memory);
+    CountedSet<GameboardModel> open(memory), closed(memory), incons(memory);
+    Queue q{greater<>(), CountedVector<Entry>(memory)};
+
+    double w = initialWeight;
+    size_t goalDist = SIZE_MAX;
+    GameboardModel goal;
+
+    info.emplace(src, Info{0, evaluate(*h, src), Move(0, 0)});
+    open.insert(src);
+    q.emplace(w*info.at(src).h, 0, src);
+    if(src.isGameOver()){ goalDist = 0; goal = src; }
+
+    bool timeout = false;
+    while(true) {
+        // Improve path with current weight
+        while(!q.empty()) {
+            const Entry &top = q.top();
+            const GameboardModel &u = get<2>(top);
+            if(!open.count(u) || get<1>(top) != info.at(u).g) { q.pop(); continue; }
+            if(static_cast<double>(goalDist) <= get<0>(top)) break;
+            if(expired()){ timeout = true; break; }
+            checkCancelled("AnytimeAstarSearch");
+
+            GameboardModel s = u;
+            q.pop();
+            open.erase(s);
+            closed.insert(s);
+
+            const size_t gs = info.at(s).g;
+            vector<Move> moves = expand(s);
+            vector<GameboardModel> children;
+            vector<Move> unseen;
+            vector<size_t> unseenIdx;
+            for(const Move &m: moves) {
+                children.push_back(s);
+                children.back().move(m);
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                if(!info.count(children.back())){ unseen.push_back(m); unseenIdx.push_back(children.size()-1); }
+            }
+            vector<double> hs(unseen.size());
+            evaluate(*h, s, unseen, hs.data());
+            for(size_t k = 0; k < unseen.size(); ++k) {
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                info.emplace(children[unseenIdx[k]], Info{SIZE_MAX, hs[k], unseen[k]});
+            }
+            for(size_t k = 0; k < moves.size(); ++k) {
+                const GameboardModel &v = children[k];
+                const Move &m = moves[k];
+                Info &iv = info.at(v);
+                if(iv.g <= gs + 1){ ++stats.duplicates; continue; }
+                if(iv.g != SIZE_MAX) ++stats.reopened;
+                iv.g = gs + 1;
+                iv.prev = m;
+                if(v.isGameOver() && iv.g < goalDist){ goalDist = iv.g; goal = v; }
+                if(closed.count(v)) {
+                    incons.insert(v);
+                } else {
+                    open.insert(v);
+                    q.emplace(static_cast<double>(iv.g) + w*iv.h, iv.g, v);
+                }
+            }
+            stats.updateOpen(open.size());
+        }
+
+        // Suboptimality bound of the incumbent
+        double lowerBound = static_cast<double>(goalDist);
+        for(const CountedSet<GameboardModel> *l: {&open, &incons})
+            for(const GameboardModel &s: *l)
+                lowerBound = min(lowerBound, static_cast<double>(info.at(s).g) + info.at(s).h);
+        const double bound = (goalDist == SIZE_MAX ? Heuristic::INF :
+                              lowerBound <= 0.0 ? 1.0 : min(w, static_cast<double>(goalDist)/lowerBound));
+
+        // Publish improvement
+        if(goalDist != SIZE_MAX && (improvements.empty() || improvements.back().moves.size() > goalDist)) {
+            Improvement imp{w, bound, chrono::duration_cast<chrono::nanoseconds>(hrc::now() - begin), {}};
+            GameboardModel v = goal;
+            while(v != src) {
+                const Move &m = info.at(v).prev;
+                imp.moves.push_front(m);
+                v.reverseMove(m);
+            }
+            improvements.push_back(imp);
+            if(callback) callback(improvements.back());
+        }
+
+        if(timeout || bound <= 1.0 || w <= 1.0 || weightStep <= 0.0 || expired()) break;
+
+        // Decrease weight, reuse open list and inconsistent states
+        w = max(1.0, w - weightStep);
+        for(const GameboardModel &s: incons) open.insert(s);
+        incons.clear();
+        closed.clear();
+        q = Queue(greater<>(), CountedVector<Entry>(memory));
+        for(const GameboardModel &s: open) {
+            const Info &is = info.at(s);
+            q.emplace(static_cast<double>(is.g) + w*is.h, is.g, s);
+        }
+    }
+
+    if(improvements.empty()) throw failed_to_find_solution("AnytimeAstarSearch");
+    solution.assign(improvements.back().moves.begin(), improvements.back().moves.end());
+}
+
+GameboardModel::Move AnytimeAstarSearch::next() {
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+AnytimeAstarSearch::~AnytimeAstarSearch() {
+    delete h;
+}
@@ -2,8 +2,8 @@
 // Distributed under the terms of the GNU General Public License, version 3
 
 #include "algorithm/AstarSearch.h"
+#include "algorithm/DeadlockDetector.h"
 
-#include <map>
 #include <queue>
 
 using namespace std;
@@ -15,24 +15,26 @@ AstarSearch::AstarSearch(const Heuristic *heuristic):
 }
 
 void AstarSearch::initialize(const GameboardModel &src){
-    set<GameboardModel> visited;
-    map<GameboardModel, Move> prev;
-    map<GameboardModel, size_t> dist;
+    checkSolvable(src, "AstarSearch");
+    CountedSet<GameboardModel> visited(memory);
+    CountedMap<GameboardModel, Move> prev(memory);
+    CountedMap<GameboardModel, size_t> dist(memory);
 
     GameboardModel finalGameboard = src;
     {
         priority_queue<
             pair<double, GameboardModel>,
-            vector< pair<double, GameboardModel> >,
+            CountedVector< pair<double, GameboardModel> >,
             greater<>
-        > q;
+        > q{greater<>(), CountedVector< pair<double, GameboardModel> >(memory)};
 
         dist.emplace(src, 0);
         prev.emplace(src, Move(0,0));
-        q.emplace((*h)(src), src);
+        q.emplace(evaluate(*h, src), src);
 
         GameboardModel u;
         while (!q.empty()) {
+            checkCancelled("AstarSearch");
             u = q.top().second;
             q.pop();
 
@@ -41,19 +43,40 @@ void AstarSearch::initialize(const GameboardModel &src){
                 break;
             }
 
-            if (visited.count(u)) continue;
-            visited.insert(u);
+            {
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                if (!visited.insert(u).second) continue;
+            }
 
-            vector<Move> moves = u.getAllMoves();
+            vector<Move> moves = expand(u);
+            vector<Move> fresh;
+            vector<GameboardModel> children;
+            children.reserve(moves.size());
             for (const Move &e: moves) {
-                GameboardModel v = u;
+                children.push_back(u);
+                GameboardModel &v = children.back();
                 v.move(e);
-                if(!dist.count(v) || dist.at(v) > dist.at(u) + 1) {
-                    dist.emplace(v, dist.at(u) + 1);
-                    prev.emplace(v, e);
-                    q.emplace(static_cast<double>(dist.at(v)) + (*h)(v), v);
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                const bool known = dist.count(v);
+                if((!known || dist.at(v) > dist.at(u) + 1) && !DeadlockDetector::isDead(v)) {
+                    if(known) {
+                        // Shorter path to a state seen before: reopen it, even if it was already expanded
+                        ++stats.reopened;
+                        visited.erase(v);
+                    }
+                    dist[v] = dist.at(u) + 1;
+                    prev.insert_or_assign(v, e);
+                    fresh.push_back(e);
+                } else {
+                    if(known) ++stats.duplicates;
+                    children.pop_back();
                 }
             }
+            vector<double> scores(fresh.size());
+            evaluate(*h, u, fresh, scores.data());
+            for (size_t i = 0; i < fresh.size(); ++i)
+                q.emplace(static_cast<double>(dist.at(children[i])) + scores[i], children[i]);
+            stats.updateOpen(q.size());
         }
     }
     if(!finalGameboard.isGameOver()) throw failed_to_find_solution("AstarSearch");
@@ -74,6 +97,10 @@ GameboardModel::Move AstarSearch::next() {
     return ret;
 }
 
+bool AstarSearch::isOptimal() const {
+    return h->isAdmissible();
+}
+
 AstarSearch::~AstarSearch() {
     delete h;
 }
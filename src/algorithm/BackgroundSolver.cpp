@@ -0,0 +1,102 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/BackgroundSolver.h"
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+BackgroundSolver::BackgroundSolver(SearchStrategy *searchStrategy):
+    strategy(searchStrategy),
+    worker(&BackgroundSolver::run, this)
+{
+}
+
+void BackgroundSolver::run() {
+    unique_lock<mutex> lock(m);
+    while(true) {
+        cv.wait(lock, [this](){ return stop || hasPending; });
+        if(stop) return;
+
+        hasPending = false;
+        const size_t gen = generation;
+        const GameboardModel gameboard = current;
+        strategy->resetCancel();
+        lock.unlock();
+
+        bool ok = true;
+        try {
+            strategy->initialize(gameboard);
+            GameboardModel v = gameboard;
+            while(!v.isGameOver()) {
+                if(strategy->isCancelled()) throw SearchStrategy::failed_to_find_solution("BackgroundSolver: cancelled");
+                const Move mv = strategy->next();
+                if(!v.canMove(mv)) throw SearchStrategy::failed_to_find_solution("BackgroundSolver: invalid move");
+                v.move(mv);
+                // Publish each move right away
+                lock_guard<mutex> publish(m);
+                if(gen != generation) break;
+                solution.push_back(mv);
+                cv.notify_all();
+            }
+        } catch(const exception &) {
+            ok = false;
+        }
+
+        lock.lock();
+        if(gen != generation) continue;
+        finished = true;
+        failed = !ok;
+        cv.notify_all();
+    }
+}
+
+BackgroundSolver::Status BackgroundSolver::status() const {
+    if(!solution.empty()) return SOLVED;
+    if(!finished) return SOLVING;
+    return (failed ? FAILED : SOLVED);
+}
+
+void BackgroundSolver::submit(const GameboardModel &gameboard) {
+    lock_guard<mutex> lock(m);
+    if(!solution.empty()) {
+        GameboardModel v = current;
+        v.move(solution.front());
+        if(v == gameboard) {
+            current = gameboard;
+            solution.pop_front();
+            return;
+        }
+    }
+    ++generation;
+    current = gameboard;
+    finished = false;
+    failed = false;
+    solution.clear();
+    hasPending = true;
+    strategy->cancel();
+    cv.notify_all();
+}
+
+BackgroundSolver::Status BackgroundSolver::getStatus() {
+    lock_guard<mutex> lock(m);
+    return status();
+}
+
+GameboardModel::Move BackgroundSolver::next() {
+    unique_lock<mutex> lock(m);
+    cv.wait(lock, [this](){ return status() != SOLVING; });
+    if(status() == FAILED) throw SearchStrategy::failed_to_find_solution("BackgroundSolver");
+    if(solution.empty()) return Move(0, 0);
+    return solution.front();
+}
+
+BackgroundSolver::~BackgroundSolver() {
+    {
+        lock_guard<mutex> lock(m);
+        stop = true;
+        strategy->cancel();
+        cv.notify_all();
+    }
+    worker.join();
+}
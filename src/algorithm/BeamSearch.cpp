@@ -0,0 +1,139 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/BeamSearch.h"
+#include "algorithm/DeadlockDetector.h"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+namespace {
+    /**
+     * @brief State kept in a layer of the beam.
+     */
+    struct Node {
+        GameboardModel state;
+        size_t parent;          ///< @brief Index of parent in the previous layer.
+        Move move;              ///< @brief Move that leads from the parent to this state.
+        Node(const GameboardModel &s, size_t p, const Move &m): state(s), parent(p), move(m) {}
+    };
+
+    size_t heapSize(const Node &n) {
+        return heapSize(n.state);
+    }
+}
+
+BeamSearch::BeamSearch(const Heuristic *heuristic, size_t beamWidth, size_t nRestarts):
+    h(heuristic),
+    width(max(beamWidth, size_t(1))),
+    restarts(nRestarts)
+{
+}
+
+bool BeamSearch::beam(const GameboardModel &src, size_t w) {
+    CountedVector< CountedVector<Node> > layers(memory);
+    CountedSet<GameboardModel> kept(memory);
+
+    layers.emplace_back(memory);
+    layers.back().emplace_back(src, 0, Move(0, 0));
+    kept.insert(src);
+
+    if(src.isGameOver()) return true;
+
+    while(!layers.back().empty()) {
+        const CountedVector<Node> &layer = layers.back();
+
+        // Generate next layer, keeping the best score of each distinct state
+        CountedVector<Node> candidates(memory);
+        vector< tuple<double, size_t> > scores;
+        CountedMap<GameboardModel, size_t> indexOf(memory);
+        for(size_t i = 0; i < layer.size(); ++i) {
+            checkCancelled("BeamSearch");
+            const GameboardModel &u = layer[i].state;
+            vector<Move> moves = expand(u);
+            vector<Move> fresh;
+            vector<GameboardModel> children;
+            children.reserve(moves.size());
+            for(const Move &m: moves) {
+                children.push_back(u);
+                const GameboardModel &v = children.back();
+                children.back().move(m);
+                bool known;
+                {
+                    SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                    known = kept.count(v);
+                }
+                if(known) ++stats.duplicates;
+                if(known || DeadlockDetector::isDead(v)){ children.pop_back(); continue; }
+
+                if(v.isGameOver()) {
+                    solution.push_front(m);
+                    for(size_t d = layers.size()-1, j = i; d > 0; --d) {
+                        const Node &n = layers[d][j];
+                        solution.push_front(n.move);
+                        j = n.parent;
+                    }
+                    return true;
+                }
+                fresh.push_back(m);
+            }
+
+            vector<double> values(fresh.size());
+            evaluate(*h, u, fresh, values.data());
+            for(size_t k = 0; k < fresh.size(); ++k) {
+                const GameboardModel &v = children[k];
+                const Move &m = fresh[k];
+                const double score = values[k];
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                auto it = indexOf.find(v);
+                if(it != indexOf.end()) ++stats.duplicates;
+                if(it == indexOf.end()) {
+                    indexOf.emplace(v, candidates.size());
+                    scores.emplace_back(score, candidates.size());
+                    candidates.emplace_back(v, i, m);
+                } else if(score < get<0>(scores[it->second])) {
+                    get<0>(scores[it->second]) = score;
+                    candidates[it->second] = Node(v, i, m);
+                }
+            }
+        }
+
+        stats.updateOpen(candidates.size());
+
+        // Keep the w best candidates; ties are broken by generation order
+        size_t n = min(w, scores.size());
+        partial_sort(scores.begin(), scores.begin() + static_cast<long>(n), scores.end());
+        CountedVector<Node> next(memory);
+        next.reserve(n);
+        for(size_t k = 0; k < n; ++k) {
+            const Node &node = candidates[get<1>(scores[k])];
+            kept.insert(node.state);
+            next.push_back(node);
+        }
+        layers.push_back(move(next));
+    }
+
+    return false;
+}
+
+void BeamSearch::initialize(const GameboardModel &gameboard) {
+    checkSolvable(gameboard, "BeamSearch");
+    size_t w = width;
+    for(size_t attempt = 0; attempt <= restarts; ++attempt, w *= 2) {
+        solution.clear();
+        if(beam(gameboard, w)) return;
+    }
+    throw failed_to_find_solution("BeamSearch");
+}
+
+GameboardModel::Move BeamSearch::next() {
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+BeamSearch::~BeamSearch() {
+    delete h;
+}
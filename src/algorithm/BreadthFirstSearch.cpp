@@ -6,12 +6,13 @@ using Move = GameboardModel::Move;
 bool BreadthFirstSearch::bfs(const GameboardModel& gameboardModel) {
     prev.clear();
 
-    queue<GameboardModel> q;
+    queue<GameboardModel, CountedDeque<GameboardModel> > q{CountedDeque<GameboardModel>(memory)};
 
     q.push(gameboardModel);
     prev.emplace(gameboardModel, GameboardModel::Move(0, 0));
 
     while(!q.empty()) {
+        checkCancelled("BreadthFirstSearch");
 
         GameboardModel u = q.front();
         q.pop();
@@ -21,23 +22,27 @@ bool BreadthFirstSearch::bfs(const GameboardModel& gameboardModel) {
             return true;
         }
 
-        vector<GameboardModel::Move> moves = u.getAllMoves();
+        vector<GameboardModel::Move> moves = expand(u);
 
         for(const GameboardModel::Move& m: moves) {
             GameboardModel v = u;
             v.move(m);
-            if(!prev.count(v)) {
-                q.push(v);
-                prev.emplace(v, m);
+            bool fresh;
+            {
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                fresh = prev.emplace(v, m).second;
             }
-             
+            if(fresh) q.push(v);
+            else      ++stats.duplicates;
         }
+        stats.updateOpen(q.size());
     }
    
    return false;
 }
 
 void BreadthFirstSearch::initialize(const GameboardModel &gameboard) {
+    checkSolvable(gameboard, "BreadthFirstSearch");
     this->initialState = gameboard;
     
     if(!bfs(gameboard)) throw SearchStrategy::failed_to_find_solution("BreadthFirstSearch");
@@ -48,7 +53,7 @@ void BreadthFirstSearch::initialize(const GameboardModel &gameboard) {
         solution.push(m);
         v.reverseMove(m);
     }
-
+    prev.clear();
 }
 
 GameboardModel::Move BreadthFirstSearch::next() {
@@ -58,3 +63,7 @@ GameboardModel::Move BreadthFirstSearch::next() {
     return nextMove;
 }
 
+bool BreadthFirstSearch::isOptimal() const {
+    return true;
+}
+
@@ -0,0 +1,77 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/CachedSearch.h"
+
+#include <utility>
+#include <vector>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+CachedSearch::CachedSearch(SearchStrategy *searchStrategy, shared_ptr<SolutionCache> solutionCache):
+    search(searchStrategy),
+    cache(move(solutionCache))
+{
+}
+
+void CachedSearch::initialize(const GameboardModel &gameboard) {
+    solution.clear();
+    vector<Move> moves;
+    const bool optimal = search->isOptimal();
+    if(!cache->lookup(gameboard, moves, optimal)) {
+        search->initialize(gameboard);
+        GameboardModel g = gameboard;
+        while(!g.isGameOver()) {
+            checkCancelled("CachedSearch");
+            moves.push_back(search->next());
+            g.move(moves.back());
+        }
+        cache->store(gameboard, moves, optimal);
+    }
+    solution.assign(moves.begin(), moves.end());
+}
+
+GameboardModel::Move CachedSearch::next() {
+    if(solution.empty()) return Move(0, 0);
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+bool CachedSearch::isOptimal() const {
+    return search->isOptimal();
+}
+
+void CachedSearch::cancel() {
+    SearchStrategy::cancel();
+    search->cancel();
+}
+
+void CachedSearch::resetCancel() {
+    SearchStrategy::resetCancel();
+    search->resetCancel();
+}
+
+size_t CachedSearch::getMemory() const {
+    return SearchStrategy::getMemory() + search->getMemory();
+}
+
+void CachedSearch::resetMemoryPeak() {
+    SearchStrategy::resetMemoryPeak();
+    search->resetMemoryPeak();
+}
+
+SearchStatistics CachedSearch::getStatistics() const {
+    SearchStatistics ret = SearchStrategy::getStatistics();
+    ret += search->getStatistics();
+    return ret;
+}
+
+void CachedSearch::resetStatistics(bool timing) {
+    SearchStrategy::resetStatistics(timing);
+    search->resetStatistics(timing);
+}
+
+CachedSearch::~CachedSearch() {
+    delete search;
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/DeadlockDetector.h"
+#include "model/PackedBoard.h"
+
+#include <map>
+#include <queue>
+#include <string>
+#include <unordered_set>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+DeadlockDetector::DeadlockDetector(size_t closureBudget):
+    budget(closureBudget)
+{
+}
+
+bool DeadlockDetector::isMalformed(const GameboardModel &g) {
+    map<color_t, size_t> count;
+    for(const Tube &t: g)
+        for(const color_t &c: t)
+            ++count[c];
+    for(const auto &p: count)
+        if(p.second % g.tubeHeight() != 0) return true;
+    return false;
+}
+
+bool DeadlockDetector::isDead(const GameboardModel &g) {
+    const size_t n = g.size(), H = g.tubeHeight();
+    bool hasEmpty = false, hasPieces = false;
+    for(const Tube &t: g) {
+        if(t.empty()) hasEmpty  = true;
+        else          hasPieces = true;
+    }
+    if(!hasPieces) return false;
+    if(hasEmpty) return false;
+    for(size_t i = 0; i < n; ++i) {
+        if(g[i].size() >= H) continue;
+        for(size_t j = 0; j < n; ++j)
+            if(j != i && g[j].back() == g[i].back()) return false;
+    }
+    return !g.isGameOver();
+}
+
+DeadlockDetector::Verdict DeadlockDetector::analyse(const GameboardModel &g) const {
+    if(g.isGameOver()) return ALIVE;
+    if(isMalformed(g) || isDead(g)) return DEAD;
+    if(g.tubeHeight() > 64) return UNKNOWN;
+
+    // Explore in packed form, which is much cheaper to copy, hash and expand
+    const size_t R = g.packedSize();
+    PackedBoard b(g.size(), g.tubeHeight()), c(g.size(), g.tubeHeight());
+    unordered_set<string> visited;
+    queue<string> q;
+    string u(R, '\0'), v(R, '\0');
+    g.pack(reinterpret_cast<uint8_t*>(&u[0]));
+    visited.insert(u);
+    q.push(u);
+    vector<Move> moves;
+    while(!q.empty()) {
+        u = q.front(); q.pop();
+        b.load(reinterpret_cast<const uint8_t*>(u.data()));
+        b.getAllMoves(moves);
+        for(const Move &m: moves) {
+            b.move(m, reinterpret_cast<uint8_t*>(&v[0]));
+            if(visited.count(v)) continue;
+            c.load(reinterpret_cast<const uint8_t*>(v.data()));
+            if(c.isGameOver()) return ALIVE;
+            if(visited.size() >= budget) return UNKNOWN;
+            visited.insert(v);
+            q.push(v);
+        }
+    }
+    return DEAD;
+}
@@ -2,33 +2,37 @@
 // Distributed under the terms of the GNU General Public License, version 3
 
 #include "algorithm/DepthFirstGreedySearch.h"
+#include "algorithm/visited/ExactVisitedSet.h"
 
 #include <algorithm>
 
 using namespace std;
 using Move = GameboardModel::Move;
 
-DepthFirstGreedySearch::DepthFirstGreedySearch(const Heuristic *heuristic):
-    h(heuristic)
+DepthFirstGreedySearch::DepthFirstGreedySearch(const Heuristic *heuristic, VisitedSet *visitedSet):
+    h(heuristic),
+    visited(visitedSet != nullptr ? visitedSet : new ExactVisitedSet())
 {
 }
 
 bool DepthFirstGreedySearch::dfs(const GameboardModel& gameBoard) {
-    if (visited.count(gameBoard)) return false;
-
-    visited.insert(gameBoard);
+    checkCancelled("DepthFirstGreedySearch");
+    {
+        SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+        if (visited->contains(gameBoard)){ ++stats.duplicates; return false; }
+        visited->insert(gameBoard);
+    }
+    stats.updateOpen(solution.size());
 
     if (gameBoard.isGameOver()) return true;
 
-    vector<Move> moves = gameBoard.getAllMoves();
+    vector<Move> moves = expand(gameBoard);
     {
+        vector<double> scores(moves.size());
+        evaluate(*h, gameBoard, moves, scores.data());
         vector<pair<double, Move> > moves_scores;
-        for (const Move &move : moves) {
-            GameboardModel state = gameBoard;
-            state.move(move);
-            double score = (*h)(state);
-            moves_scores.emplace_back(score, move);
-        }
+        for (size_t i = 0; i < moves.size(); ++i)
+            moves_scores.emplace_back(scores[i], moves[i]);
         sort(moves_scores.begin(), moves_scores.end());
         for (size_t i = 0; i < moves.size(); ++i)
             moves[i] = moves_scores[i].second;
@@ -45,7 +49,9 @@ bool DepthFirstGreedySearch::dfs(const GameboardModel& gameBoard) {
 }
 
 void DepthFirstGreedySearch::initialize(const GameboardModel &gameboardModel){
-    visited.clear();
+    checkSolvable(gameboardModel, "DepthFirstGreedySearch");
+    visited->clear();
+    solution.clear();
 
     if (!dfs(gameboardModel)) throw SearchStrategy::failed_to_find_solution("DepthFirstGreedySearch");
 }
@@ -54,3 +60,11 @@ GameboardModel::Move DepthFirstGreedySearch::next() {
     Move ret = solution.front(); solution.pop_front();
     return ret;
 }
+
+size_t DepthFirstGreedySearch::getMemory() const {
+    return SearchStrategy::getMemory() + visited->getMemory();
+}
+
+DepthFirstGreedySearch::~DepthFirstGreedySearch() {
+    delete visited;
+}
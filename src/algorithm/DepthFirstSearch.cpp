@@ -2,18 +2,29 @@
 // Distributed under the terms of the GNU General Public License, version 3
 
 #include "algorithm/DepthFirstSearch.h"
+#include "algorithm/visited/ExactVisitedSet.h"
 
 using namespace std;
 
 using Move = GameboardModel::Move;
 
+DepthFirstSearch::DepthFirstSearch(VisitedSet *visitedSet):
+    visited(visitedSet != nullptr ? visitedSet : new ExactVisitedSet())
+{
+}
+
 bool DepthFirstSearch::dfs(const GameboardModel& gameBoard) {
-    if (visited.count(gameBoard)) return false;
-    visited.insert(gameBoard);
+    checkCancelled("DepthFirstSearch");
+    {
+        SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+        if (visited->contains(gameBoard)){ ++stats.duplicates; return false; }
+        visited->insert(gameBoard);
+    }
+    stats.updateOpen(solution.size());
 
     if (gameBoard.isGameOver()) return true;
 
-    vector<Move> moves = gameBoard.getAllMoves();
+    vector<Move> moves = expand(gameBoard);
     for (const Move &move : moves){
         GameboardModel state = gameBoard;
         state.move(move);
@@ -22,13 +33,14 @@ bool DepthFirstSearch::dfs(const GameboardModel& gameBoard) {
         solution.pop_back();
     }
 
-    visited.erase(gameBoard);
+    visited->erase(gameBoard);
 
     return false;
 }
 
 void DepthFirstSearch::initialize(const GameboardModel &gameboardModel){
-    visited.clear();
+    checkSolvable(gameboardModel, "DepthFirstSearch");
+    visited->clear();
     solution.clear();
 
     if (!dfs(gameboardModel)) throw SearchStrategy::failed_to_find_solution("DepthFirstSearch");
@@ -38,3 +50,11 @@ GameboardModel::Move DepthFirstSearch::next() {
     Move ret = solution.front(); solution.pop_front();
     return ret;
 }
+
+size_t DepthFirstSearch::getMemory() const {
+    return SearchStrategy::getMemory() + visited->getMemory();
+}
+
+DepthFirstSearch::~DepthFirstSearch() {
+    delete visited;
+}
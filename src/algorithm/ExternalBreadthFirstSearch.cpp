@@ -0,0 +1,329 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/ExternalBreadthFirstSearch.h"
+#include "model/PackedBoard.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+namespace {
+    const size_t CHUNK_RECORDS = 4096;
+    const size_t MERGE_FAN_IN = 64;     ///< @brief Maximum number of files merged at once.
+
+    FILE *openFile(const string &path, const char *mode) {
+        FILE *f = fopen(path.c_str(), mode);
+        if(f == nullptr) throw runtime_error("ExternalBreadthFirstSearch: failed to open " + path);
+        return f;
+    }
+
+    /**
+     * @brief Sequential reader of a file of fixed-size records.
+     */
+    class RecordReader {
+    private:
+        FILE *f;
+        size_t R;
+        vector<uint8_t> buf;
+        size_t n = 0, i = 0;
+        void fill() {
+            n = fread(buf.data(), R, CHUNK_RECORDS, f);
+            i = 0;
+        }
+    public:
+        RecordReader(const string &path, size_t recordSize):
+            f(openFile(path, "rb")), R(recordSize), buf(recordSize*CHUNK_RECORDS)
+        {
+            fill();
+        }
+        RecordReader(const RecordReader &) = delete;
+        RecordReader &operator=(const RecordReader &) = delete;
+        bool done() const { return i >= n; }
+        const uint8_t *get() const { return &buf[i*R]; }
+        void advance() { if(++i >= n) fill(); }
+        ~RecordReader() { fclose(f); }
+    };
+
+    /**
+     * @brief Sequential writer of a file of fixed-size records.
+     */
+    class RecordWriter {
+    private:
+        FILE *f;
+        size_t R;
+        size_t count = 0;
+    public:
+        RecordWriter(const string &path, size_t recordSize):
+            f(openFile(path, "wb")), R(recordSize)
+        {
+        }
+        RecordWriter(const RecordWriter &) = delete;
+        RecordWriter &operator=(const RecordWriter &) = delete;
+        void write(const uint8_t *rec) {
+            if(fwrite(rec, R, 1, f) != 1) throw runtime_error("ExternalBreadthFirstSearch: failed to write");
+            ++count;
+        }
+        size_t size() const { return count; }
+        ~RecordWriter() { fclose(f); }
+    };
+
+    /**
+     * @brief K-way merge of sorted files of records, using a heap; repeated records are all returned.
+     */
+    class RecordMerger {
+    private:
+        size_t R;
+        vector< unique_ptr<RecordReader> > readers;
+        vector<RecordReader*> heap;
+        bool greater(const RecordReader *a, const RecordReader *b) const {
+            return memcmp(a->get(), b->get(), R) > 0;
+        }
+    public:
+        RecordMerger(const vector<string> &paths, size_t recordSize):
+            R(recordSize)
+        {
+            auto cmp = [this](const RecordReader *a, const RecordReader *b){ return greater(a, b); };
+            for(const string &path: paths) {
+                readers.emplace_back(new RecordReader(path, R));
+                if(readers.back()->done()) continue;
+                heap.push_back(readers.back().get());
+                push_heap(heap.begin(), heap.end(), cmp);
+            }
+        }
+        bool done() const { return heap.empty(); }
+        const uint8_t *get() const { return heap.front()->get(); }
+        void advance() {
+            auto cmp = [this](const RecordReader *a, const RecordReader *b){ return greater(a, b); };
+            pop_heap(heap.begin(), heap.end(), cmp);
+            heap.back()->advance();
+            if(heap.back()->done()) heap.pop_back();
+            else push_heap(heap.begin(), heap.end(), cmp);
+        }
+    };
+
+    /**
+     * @brief Merge sorted files of records into one, without repetitions.
+     */
+    void mergeFiles(const vector<string> &paths, size_t R, const string &path) {
+        RecordWriter w(path, R);
+        vector<uint8_t> last(R);
+        bool first = true;
+        for(RecordMerger in(paths, R); !in.done(); in.advance()) {
+            if(!first && memcmp(in.get(), last.data(), R) == 0) continue;
+            first = false;
+            memcpy(last.data(), in.get(), R);
+            w.write(in.get());
+        }
+    }
+
+    /**
+     * @brief Sort the first n records in buf, and write them to a file without repetitions.
+     */
+    void writeSortedRun(const CountedVector<uint8_t> &buf, size_t n, size_t R, const string &path) {
+        vector<const uint8_t*> recs(n);
+        for(size_t i = 0; i < n; ++i) recs[i] = &buf[i*R];
+        sort(recs.begin(), recs.end(), [R](const uint8_t *a, const uint8_t *b){ return memcmp(a, b, R) < 0; });
+        RecordWriter w(path, R);
+        for(size_t i = 0; i < n; ++i)
+            if(i == 0 || memcmp(recs[i-1], recs[i], R) != 0) w.write(recs[i]);
+    }
+
+    /**
+     * @brief Check if a sorted file of records contains a record, using binary search.
+     */
+    bool containsRecord(const string &path, size_t R, const uint8_t *rec) {
+        unique_ptr<FILE, int(*)(FILE*)> f(openFile(path, "rb"), fclose);
+        fseek(f.get(), 0, SEEK_END);
+        long lo = 0, hi = ftell(f.get()) / static_cast<long>(R);
+        vector<uint8_t> cur(R);
+        while(lo < hi) {
+            long mid = lo + (hi-lo)/2;
+            fseek(f.get(), mid * static_cast<long>(R), SEEK_SET);
+            if(fread(cur.data(), R, 1, f.get()) != 1) throw runtime_error("ExternalBreadthFirstSearch: failed to read");
+            int c = memcmp(cur.data(), rec, R);
+            if(c == 0) return true;
+            if(c < 0) lo = mid+1;
+            else      hi = mid;
+        }
+        return false;
+    }
+
+    atomic<unsigned long> instances(0);
+}
+
+ExternalBreadthFirstSearch::ExternalBreadthFirstSearch(const string &dir, size_t buffer):
+    directory(dir),
+    bufferStates(max(buffer, size_t(1))),
+    prefix("bfs-" + to_string(getpid()) + "-" + to_string(instances++))
+{
+}
+
+string ExternalBreadthFirstSearch::fileName(const string &what, size_t i) const {
+    return directory + "/" + prefix + "-" + what + "-" + to_string(i) + ".bin";
+}
+
+void ExternalBreadthFirstSearch::removeFiles() {
+    if(!closed.empty() && (layers.empty() || closed != layers[0])) remove(closed.c_str());
+    closed.clear();
+    for(const string &path: layers) remove(path.c_str());
+    layers.clear();
+}
+
+size_t ExternalBreadthFirstSearch::expandLayer(GameboardModel &model, vector<uint8_t> &goal, bool &found) {
+    const size_t R = model.packedSize();
+    const size_t d = layers.size()-1;
+
+    // Expand layer d into sorted runs
+    vector<string> runs;
+    size_t nRunFiles = 0;
+    {
+        CountedVector<uint8_t> buf(bufferStates*R, 0, memory);
+        size_t n = 0;
+        auto flush = [&](){
+            if(n == 0) return;
+            runs.push_back(fileName("run", nRunFiles++));
+            writeSortedRun(buf, n, R, runs.back());
+            n = 0;
+        };
+        PackedBoard b(model.size(), model.tubeHeight());
+        vector<Move> moves;
+        for(RecordReader r(layers[d], R); !r.done(); r.advance()) {
+            checkCancelled("ExternalBreadthFirstSearch");
+            b.load(r.get());
+            {
+                SearchStatistics::Timer timer(stats, &SearchStatistics::moveTime);
+                b.getAllMoves(moves);
+            }
+            ++stats.expanded;
+            stats.generated += moves.size();
+            for(const Move &m: moves) {
+                b.move(m, &buf[n*R]);
+                if(++n == bufferStates) flush();
+            }
+        }
+        flush();
+    }
+
+    // Merge runs in passes until they can be merged at once
+    while(runs.size() > MERGE_FAN_IN) {
+        checkCancelled("ExternalBreadthFirstSearch");
+        vector<string> merged;
+        for(size_t i = 0; i < runs.size(); i += MERGE_FAN_IN) {
+            const vector<string> group(runs.begin() + long(i), runs.begin() + long(min(i + MERGE_FAN_IN, runs.size())));
+            merged.push_back(fileName("run", nRunFiles++));
+            mergeFiles(group, R, merged.back());
+            for(const string &path: group) remove(path.c_str());
+        }
+        runs.swap(merged);
+    }
+
+    // Merge runs, drop duplicates and states in previous layers
+    layers.push_back(fileName("layer", d+1));
+    size_t count;
+    {
+        PackedBoard b(model.size(), model.tubeHeight());
+        RecordReader prev(closed, R);
+        RecordWriter out(layers.back(), R);
+        vector<uint8_t> last(R);
+        bool first = true;
+        for(RecordMerger in(runs, R); !found && !in.done(); in.advance()) {
+            const uint8_t *rec = in.get();
+            SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+            if(first || memcmp(rec, last.data(), R) != 0) {
+                first = false;
+                memcpy(last.data(), rec, R);
+                while(!prev.done() && memcmp(prev.get(), rec, R) < 0) prev.advance();
+                const bool duplicate = (!prev.done() && memcmp(prev.get(), rec, R) == 0);
+                if(duplicate) ++stats.duplicates;
+                if(!duplicate) {
+                    out.write(rec);
+                    b.load(rec);
+                    if(b.isGameOver()){
+                        found = true;
+                        goal.assign(rec, rec+R);
+                    }
+                }
+            }
+        }
+        count = out.size();
+        stats.updateOpen(count);
+    }
+    for(const string &path: runs) remove(path.c_str());
+
+    // Add the new layer to the union of the previous ones
+    if(!found && count > 0) {
+        const string next = fileName("closed", d+1);
+        mergeFiles({closed, layers.back()}, R, next);
+        if(closed != layers[0]) remove(closed.c_str());
+        closed = next;
+    }
+
+    return count;
+}
+
+void ExternalBreadthFirstSearch::initialize(const GameboardModel &gameboard) {
+    checkSolvable(gameboard, "ExternalBreadthFirstSearch");
+    solution.clear();
+    removeFiles();
+
+    GameboardModel model = gameboard;
+    const size_t R = model.packedSize();
+    vector<uint8_t> goal(R);
+    try {
+        layers.push_back(fileName("layer", 0));
+        {
+            RecordWriter w(layers.back(), R);
+            model.pack(goal.data());
+            w.write(goal.data());
+        }
+        closed = layers.back();
+
+        bool found = gameboard.isGameOver();
+        while(!found) {
+            if(expandLayer(model, goal, found) == 0) throw failed_to_find_solution("ExternalBreadthFirstSearch");
+        }
+
+        // Backward pass
+        vector<uint8_t> rec(R);
+        model.unpack(goal.data());
+        for(size_t d = layers.size()-1; d > 0; --d) {
+            vector<Move> moves = model.getAllReverseMoves();
+            bool ok = false;
+            for(const Move &m: moves) {
+                model.reverseMove(m);
+                model.pack(rec.data());
+                if(containsRecord(layers[d-1], R, rec.data())) {
+                    solution.push_front(m);
+                    ok = true;
+                    break;
+                }
+                model.move(m);
+            }
+            if(!ok) throw logic_error("ExternalBreadthFirstSearch: failed to reconstruct path");
+        }
+    } catch(...) {
+        removeFiles();
+        throw;
+    }
+    removeFiles();
+}
+
+GameboardModel::Move ExternalBreadthFirstSearch::next() {
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+bool ExternalBreadthFirstSearch::isOptimal() const {
+    return true;
+}
+
+ExternalBreadthFirstSearch::~ExternalBreadthFirstSearch() {
+    removeFiles();
+}
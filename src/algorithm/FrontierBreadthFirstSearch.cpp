@@ -0,0 +1,136 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/FrontierBreadthFirstSearch.h"
+
+#include <vector>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+namespace {
+    /**
+     * @brief State in the frontier.
+     */
+    struct Node {
+        CountedVector<bool> used;   ///< @brief Used-operator bits, indexed by from·nTubes + to.
+        size_t relay;               ///< @brief Index of the ancestor in the relay layer.
+    };
+
+    typedef CountedMap<GameboardModel, Node> Layer;
+
+    uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Fingerprint of a layer, including the used-operator bits that determine how it is expanded.
+     */
+    uint64_t fingerprint(const Layer &layer) {
+        uint64_t ret = layer.size();
+        for(const auto &p: layer) {
+            ret = mix(ret ^ hash<GameboardModel>()(p.first));
+            const CountedVector<bool> &used = p.second.used;
+            for(size_t k = 0; k < used.size(); ++k)
+                if(used[k]) ret = mix(ret ^ k);
+        }
+        return ret;
+    }
+}
+
+bool FrontierBreadthFirstSearch::search(const GameboardModel &src, const function<bool(const GameboardModel &)> &isGoal,
+                                        size_t relayDepth, size_t maxDepth,
+                                        GameboardModel &goal, size_t &depth, GameboardModel &relay) const {
+    const size_t n = src.size();
+
+    CountedVector<GameboardModel> relays(1, src, memory);
+    Layer cur(memory), next(memory);
+    CountedSet<uint64_t> fingerprints(memory);
+
+    cur.emplace(src, Node{CountedVector<bool>(n*n, false, memory), 0});
+    for(depth = 0; !cur.empty(); ++depth) {
+        for(const auto &p: cur) {
+            if(isGoal(p.first)) {
+                goal = p.first;
+                relay = relays.at(p.second.relay);
+                return true;
+            }
+        }
+        if(depth >= maxDepth) return false;
+        if(!fingerprints.insert(fingerprint(cur)).second) return false;
+
+        const bool isRelayLayer = (depth+1 == relayDepth);
+        CountedVector<GameboardModel> nextRelays(memory);
+        for(const auto &p: cur) {
+            checkCancelled("FrontierBreadthFirstSearch");
+            const GameboardModel &u = p.first;
+            vector<Move> moves = expand(u);
+            for(const Move &m: moves) {
+                if(p.second.used[m.from*n + m.to]){ ++stats.duplicates; continue; }
+                GameboardModel v = u;
+                v.move(m);
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                if(cur.count(v)){ ++stats.duplicates; continue; }
+                auto it = next.find(v);
+                if(it != next.end()) ++stats.duplicates;
+                if(it == next.end()) {
+                    size_t r = p.second.relay;
+                    if(isRelayLayer){ r = nextRelays.size(); nextRelays.push_back(v); }
+                    it = next.emplace(v, Node{CountedVector<bool>(n*n, false, memory), r}).first;
+                }
+                const Move rev(m.to, m.from);
+                if(v.canMove(rev)) it->second.used[rev.from*n + rev.to] = true;
+            }
+        }
+        stats.updateOpen(cur.size() + next.size());
+        if(isRelayLayer) relays.swap(nextRelays);
+        cur.swap(next);
+        next.clear();
+    }
+    return false;
+}
+
+void FrontierBreadthFirstSearch::solve(const GameboardModel &src, const GameboardModel &dst, size_t d) {
+    if(d == 0) return;
+    if(d == 1) {
+        vector<Move> moves = src.getAllMoves();
+        for(const Move &m: moves) {
+            GameboardModel v = src;
+            v.move(m);
+            if(v == dst){ solution.push_back(m); return; }
+        }
+        throw logic_error("FrontierBreadthFirstSearch: states are not adjacent");
+    }
+
+    const size_t mid = d/2;
+    GameboardModel goal, relay;
+    size_t depth;
+    if(!search(src, [&dst](const GameboardModel &g){ return g == dst; }, mid, d, goal, depth, relay) || depth != d)
+        throw logic_error("FrontierBreadthFirstSearch: failed to find relay state");
+    solve(src, relay, mid);
+    solve(relay, dst, d - mid);
+}
+
+void FrontierBreadthFirstSearch::initialize(const GameboardModel &gameboard) {
+    checkSolvable(gameboard, "FrontierBreadthFirstSearch");
+    solution.clear();
+
+    GameboardModel goal, relay;
+    size_t depth;
+    if(!search(gameboard, [](const GameboardModel &g){ return g.isGameOver(); }, SIZE_MAX, SIZE_MAX, goal, depth, relay))
+        throw failed_to_find_solution("FrontierBreadthFirstSearch");
+
+    solve(gameboard, goal, depth);
+}
+
+GameboardModel::Move FrontierBreadthFirstSearch::next() {
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+bool FrontierBreadthFirstSearch::isOptimal() const {
+    return true;
+}
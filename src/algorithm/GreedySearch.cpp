@@ -2,8 +2,8 @@
 // Distributed under the terms of the GNU General Public License, version 3
 
 #include "algorithm/GreedySearch.h"
+#include "algorithm/DeadlockDetector.h"
 
-#include <map>
 #include <queue>
 
 using namespace std;
@@ -15,22 +15,24 @@ GreedySearch::GreedySearch(const Heuristic *heuristic):
 }
 
 void GreedySearch::initialize(const GameboardModel &src){
-    set<GameboardModel> visited;
-    map<GameboardModel, Move> prev;
+    checkSolvable(src, "GreedySearch");
+    CountedSet<GameboardModel> visited(memory);
+    CountedMap<GameboardModel, Move> prev(memory);
 
     GameboardModel finalGameboard = src;
     {
         priority_queue<
             pair<double, GameboardModel>,
-            vector< pair<double, GameboardModel> >,
+            CountedVector< pair<double, GameboardModel> >,
             greater<>
-        > q;
+        > q{greater<>(), CountedVector< pair<double, GameboardModel> >(memory)};
 
         prev.emplace(src, Move(0,0));
-        q.emplace((*h)(src), src);
+        q.emplace(evaluate(*h, src), src);
 
         GameboardModel u;
         while (!q.empty()) {
+            checkCancelled("GreedySearch");
             u = q.top().second;
             q.pop();
 
@@ -39,18 +41,34 @@ void GreedySearch::initialize(const GameboardModel &src){
                 break;
             }
 
-            if (visited.count(u)) continue;
-            visited.insert(u);
+            {
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                if (!visited.insert(u).second) continue;
+            }
 
-            vector<Move> moves = u.getAllMoves();
+            vector<Move> moves = expand(u);
+            vector<Move> fresh;
+            vector<GameboardModel> children;
+            children.reserve(moves.size());
             for (const Move &e: moves) {
-                GameboardModel v = u;
-                v.move(e);
-                if(!visited.count(v)) {
-                    prev.emplace(v, e);
-                    q.emplace((*h)(v), v);
+                children.push_back(u);
+                children.back().move(e);
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                const bool known = visited.count(children.back());
+                if(known) ++stats.duplicates;
+                if(known || DeadlockDetector::isDead(children.back())) children.pop_back();
+                else                                                   fresh.push_back(e);
+            }
+            vector<double> scores(fresh.size());
+            evaluate(*h, u, fresh, scores.data());
+            for (size_t i = 0; i < fresh.size(); ++i) {
+                {
+                    SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                    prev.emplace(children[i], fresh[i]);
                 }
+                q.emplace(scores[i], children[i]);
             }
+            stats.updateOpen(q.size());
         }
     }
     if (!finalGameboard.isGameOver()) throw failed_to_find_solution("GreedySearch");
@@ -2,20 +2,31 @@
 // Distributed under the terms of the GNU General Public License, version 3
 
 #include "algorithm/IterativeDeepeningSearch.h"
+#include "algorithm/visited/ExactVisitedSet.h"
 
 using namespace std;
 
 using Move = GameboardModel::Move;
 
+IterativeDeepeningSearch::IterativeDeepeningSearch(VisitedSet *visitedSet):
+    visited(visitedSet != nullptr ? visitedSet : new ExactVisitedSet())
+{
+}
+
 bool IterativeDeepeningSearch::dfs(const GameboardModel& gameBoard, size_t depth) {
+    checkCancelled("IterativeDeepeningSearch");
     if (depth > maxDepth) return false;
 
-    if(visited.count(gameBoard)) return false;
-    visited.insert(gameBoard);
+    {
+        SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+        if(visited->contains(gameBoard)){ ++stats.duplicates; return false; }
+        visited->insert(gameBoard);
+    }
+    stats.updateOpen(solution.size());
 
     if (gameBoard.isGameOver()) return true;
 
-    vector<Move> moves = gameBoard.getAllMoves();
+    vector<Move> moves = expand(gameBoard);
     for (const Move &move : moves){
         GameboardModel state = gameBoard;
         state.move(move);
@@ -24,21 +35,22 @@ bool IterativeDeepeningSearch::dfs(const GameboardModel& gameBoard, size_t depth
         solution.pop_back();
     }
 
-    visited.erase(gameBoard);
+    visited->erase(gameBoard);
 
     return false;
 }
 
 void IterativeDeepeningSearch::initialize(const GameboardModel &gameboardModel){
+    checkSolvable(gameboardModel, "IterativeDeepeningSearch");
     maxDepth = 0;
 
     solution.clear();
-    visited.clear();
+    visited->clear();
 
     while (!dfs(gameboardModel, 0)){
         ++maxDepth;
         solution.clear();
-        visited.clear();
+        visited->clear();
     }
 }
 
@@ -46,3 +58,15 @@ GameboardModel::Move IterativeDeepeningSearch::next() {
     Move ret = solution.front(); solution.pop_front();
     return ret;
 }
+
+bool IterativeDeepeningSearch::isOptimal() const {
+    return dynamic_cast<const ExactVisitedSet*>(visited) != nullptr;
+}
+
+size_t IterativeDeepeningSearch::getMemory() const {
+    return SearchStrategy::getMemory() + visited->getMemory();
+}
+
+IterativeDeepeningSearch::~IterativeDeepeningSearch() {
+    delete visited;
+}
@@ -0,0 +1,28 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/MemoryCounter.h"
+
+using namespace std;
+
+void MemoryCounter::allocate(size_t bytes) {
+    const size_t now = (current += bytes);
+    size_t p = peak.load(memory_order_relaxed);
+    while(p < now && !peak.compare_exchange_weak(p, now, memory_order_relaxed));
+}
+
+void MemoryCounter::deallocate(size_t bytes) {
+    current -= bytes;
+}
+
+size_t MemoryCounter::getCurrent() const {
+    return current;
+}
+
+size_t MemoryCounter::getPeak() const {
+    return peak;
+}
+
+void MemoryCounter::resetPeak() {
+    peak = current.load();
+}
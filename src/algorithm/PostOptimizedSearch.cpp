@@ -0,0 +1,164 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/PostOptimizedSearch.h"
+#include "model/PackedBoard.h"
+
+#include <vector>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+namespace {
+    /**
+     * @brief State generated by the search for a shortcut.
+     */
+    struct Node {
+        CountedString state;    ///< @brief Packed state.
+        size_t parent;          ///< @brief Index of the parent node.
+        Move move;              ///< @brief Move from parent.
+    };
+}
+
+PostOptimizedSearch::PostOptimizedSearch(SearchStrategy *searchStrategy, size_t windowSize, size_t stateBudget):
+    search(searchStrategy),
+    window(windowSize),
+    budget(stateBudget)
+{
+}
+
+void PostOptimizedSearch::initialize(const GameboardModel &gameboard) {
+    solution.clear();
+
+    // Original solution, with states kept packed
+    search->initialize(gameboard);
+    GameboardModel g = gameboard;
+    const size_t S = g.packedSize();
+    auto pack = [this, &g, S]() {
+        CountedString ret(S, '\0', memory);
+        g.pack(reinterpret_cast<uint8_t*>(&ret[0]));
+        return ret;
+    };
+    CountedVector<CountedString> states(1, pack(), memory);
+    CountedVector<Move> moves(memory);
+    while(!g.isGameOver()) {
+        checkCancelled("PostOptimizedSearch");
+        moves.push_back(search->next());
+        g.move(moves.back());
+        states.push_back(pack());
+    }
+    const size_t L = moves.size();
+
+    // Last position of each state
+    CountedUnorderedMap<CountedString, size_t> last(memory);
+    for(size_t i = 0; i <= L; ++i) last[states[i]] = i;
+
+    PackedBoard b(gameboard.size(), gameboard.tubeHeight());
+    vector<Move> all;
+    CountedVector<Node> nodes(memory);
+    CountedUnorderedMap<CountedString, size_t> seen(memory);
+    size_t i = 0;
+    while(i < L) {
+        checkCancelled("PostOptimizedSearch");
+
+        // Best shortcut from states[i]: reach position k in d < k-i moves, maximizing k-i-d
+        size_t bestK = last.at(states[i]), bestD = 0, bestNode = 0;
+        nodes.assign(1, Node{states[i], 0, Move(0, 0)});
+        seen.clear();
+        seen.emplace(states[i], 0);
+        size_t layerBegin = 0;
+        for(size_t d = 1; d <= window && d < L-i && layerBegin < nodes.size() && nodes.size() < budget; ++d) {
+            const size_t layerEnd = nodes.size();
+            for(size_t u = layerBegin; u < layerEnd && nodes.size() < budget; ++u) {
+                b.load(reinterpret_cast<const uint8_t*>(nodes[u].state.data()));
+                {
+                    SearchStatistics::Timer timer(stats, &SearchStatistics::moveTime);
+                    b.getAllMoves(all);
+                }
+                ++stats.expanded;
+                stats.generated += all.size();
+                for(const Move &m: all) {
+                    CountedString v(S, '\0', memory);
+                    b.move(m, reinterpret_cast<uint8_t*>(&v[0]));
+                    bool inserted;
+                    {
+                        SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                        inserted = seen.emplace(v, nodes.size()).second;
+                    }
+                    if(!inserted){ ++stats.duplicates; continue; }
+                    nodes.push_back(Node{v, u, m});
+
+                    size_t k = 0;
+                    auto it = last.find(v);
+                    if(it != last.end()) k = it->second;
+                    if(k <= i + d) continue;
+                    if(k - i - d > bestK - i - bestD){ bestK = k; bestD = d; bestNode = nodes.size()-1; }
+                }
+            }
+            // Final states off the original solution also end it
+            for(size_t v = layerEnd; v < nodes.size() && bestK < L; ++v) {
+                b.load(reinterpret_cast<const uint8_t*>(nodes[v].state.data()));
+                if(b.isGameOver() && L - i - d > bestK - i - bestD){ bestK = L; bestD = d; bestNode = v; }
+            }
+            stats.updateOpen(nodes.size() - layerEnd);
+            layerBegin = layerEnd;
+        }
+
+        if(bestK == i) {
+            solution.push_back(moves[i]);
+            ++i;
+            continue;
+        }
+
+        // Splice shortcut
+        deque<Move> shortcut;
+        for(size_t v = bestNode; v != 0; v = nodes[v].parent) shortcut.push_front(nodes[v].move);
+        solution.insert(solution.end(), shortcut.begin(), shortcut.end());
+        if(bestK == L && nodes[bestNode].state != states[L]) break;
+        i = bestK;
+    }
+}
+
+GameboardModel::Move PostOptimizedSearch::next() {
+    if(solution.empty()) return Move(0, 0);
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+bool PostOptimizedSearch::isOptimal() const {
+    return search->isOptimal();
+}
+
+void PostOptimizedSearch::cancel() {
+    SearchStrategy::cancel();
+    search->cancel();
+}
+
+void PostOptimizedSearch::resetCancel() {
+    SearchStrategy::resetCancel();
+    search->resetCancel();
+}
+
+size_t PostOptimizedSearch::getMemory() const {
+    return SearchStrategy::getMemory() + search->getMemory();
+}
+
+void PostOptimizedSearch::resetMemoryPeak() {
+    SearchStrategy::resetMemoryPeak();
+    search->resetMemoryPeak();
+}
+
+SearchStatistics PostOptimizedSearch::getStatistics() const {
+    SearchStatistics ret = SearchStrategy::getStatistics();
+    ret += search->getStatistics();
+    return ret;
+}
+
+void PostOptimizedSearch::resetStatistics(bool timing) {
+    SearchStrategy::resetStatistics(timing);
+    search->resetStatistics(timing);
+}
+
+PostOptimizedSearch::~PostOptimizedSearch() {
+    delete search;
+}
@@ -0,0 +1,129 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/RealTimeSearch.h"
+#include "algorithm/DeadlockDetector.h"
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+
+using namespace std;
+using Move = GameboardModel::Move;
+using hrc = chrono::high_resolution_clock;
+typedef RealTimeSearch::heuristic_t heuristic_t;
+
+RealTimeSearch::RealTimeSearch(const Heuristic *heuristic, size_t look, long moveBudgetMs):
+    h(heuristic),
+    lookahead(max(look, size_t(1))),
+    budget(moveBudgetMs)
+{
+}
+
+void RealTimeSearch::evaluateMoves(const GameboardModel &u, const vector<Move> &moves,
+                                   vector<heuristic_t> &out) const {
+    out.resize(moves.size());
+    evaluate(*h, u, moves, out.data());
+    if(learned.empty()) return;
+    GameboardModel v = u;
+    for(size_t i = 0; i < moves.size(); ++i) {
+        v.move(moves[i]);
+        auto it = learned.find(v);
+        if(it != learned.end()) out[i] = it->second;
+        v.reverseMove(moves[i]);
+    }
+}
+
+void RealTimeSearch::initialize(const GameboardModel &gameboard) {
+    checkSolvable(gameboard, "RealTimeSearch");
+    current = gameboard;
+    learned.clear();
+    plan.clear();
+}
+
+GameboardModel::Move RealTimeSearch::next() {
+    if(current.isGameOver()) return Move(0, 0);
+    if(plan.empty()) {
+        const hrc::time_point begin = hrc::now();
+
+        typedef tuple<heuristic_t, size_t, GameboardModel> Entry;   // f, g, state
+        priority_queue<Entry, CountedVector<Entry>, greater<Entry> > q{greater<Entry>(), CountedVector<Entry>(memory)};
+        CountedMap<GameboardModel, size_t> dist(memory);
+        CountedMap<GameboardModel, Move> prev(memory);
+        CountedSet<GameboardModel> closed(memory);
+        vector<heuristic_t> scores;
+
+        dist.emplace(current, 0);
+        q.emplace(0.0, 0, current);
+        bool isGoal = false;
+        while(!q.empty()) {
+            const GameboardModel u = get<2>(q.top());
+            const size_t gu = get<1>(q.top());
+            bool stale;
+            {
+                SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                stale = (closed.count(u) || dist.at(u) != gu);
+            }
+            if(stale){ q.pop(); continue; }
+            if(u.isGameOver()){ isGoal = true; break; }
+            if(closed.size() >= lookahead || (budget.count() > 0 && !closed.empty() && hrc::now() - begin >= budget))
+                break;
+            checkCancelled("RealTimeSearch");
+            q.pop();
+            closed.insert(u);
+
+            vector<Move> all = expand(u), moves;
+            for(const Move &m: all) {
+                GameboardModel v = u;
+                v.move(m);
+                bool better;
+                {
+                    SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+                    auto it = dist.find(v);
+                    better = (it == dist.end() || it->second > gu + 1);
+                    if(!better) ++stats.duplicates;
+                    else if(it != dist.end()) ++stats.reopened;
+                }
+                if(better && !DeadlockDetector::isDead(v)) moves.push_back(m);
+            }
+            evaluateMoves(u, moves, scores);
+            for(size_t i = 0; i < moves.size(); ++i) {
+                GameboardModel v = u;
+                v.move(moves[i]);
+                dist[v] = gu + 1;
+                prev.insert_or_assign(v, moves[i]);
+                q.emplace(static_cast<heuristic_t>(gu + 1) + scores[i], gu + 1, v);
+            }
+            stats.updateOpen(q.size());
+        }
+        if(q.empty()) throw failed_to_find_solution("RealTimeSearch");
+
+        // Learn heuristic of expanded states
+        GameboardModel target = get<2>(q.top());
+        const heuristic_t fBest = get<0>(q.top());
+        for(const GameboardModel &s: closed)
+            learned[s] = fBest - static_cast<heuristic_t>(dist.at(s));
+
+        // Path to target
+        CountedDeque<Move> path(memory);
+        while(target != current) {
+            const Move &m = prev.at(target);
+            path.push_front(m);
+            target.reverseMove(m);
+        }
+        if(isGoal) plan.swap(path);
+        else       plan.push_back(path.front());
+    }
+
+    const Move ret = plan.front(); plan.pop_front();
+    current.move(ret);
+    return ret;
+}
+
+bool RealTimeSearch::plansWhilePlaying() const {
+    return true;
+}
+
+RealTimeSearch::~RealTimeSearch() {
+    delete h;
+}
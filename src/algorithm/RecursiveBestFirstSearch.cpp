@@ -0,0 +1,99 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/RecursiveBestFirstSearch.h"
+
+#include <algorithm>
+
+using namespace std;
+using Move = GameboardModel::Move;
+using heuristic_t = Heuristic::heuristic_t;
+
+namespace {
+    /**
+     * @brief Child of a state in the current path.
+     */
+    struct Child {
+        heuristic_t f;      ///< @brief Static f-value.
+        heuristic_t F;      ///< @brief Backed-up f-value.
+        Move move;
+        bool operator<(const Child &c) const { return F < c.F; }
+    };
+}
+
+RecursiveBestFirstSearch::RecursiveBestFirstSearch(const Heuristic *heuristic):
+    h(heuristic)
+{
+}
+
+heuristic_t RecursiveBestFirstSearch::rbfs(const GameboardModel &u, size_t g, heuristic_t fu, heuristic_t F,
+                                           heuristic_t bound, bool &found) {
+    checkCancelled("RecursiveBestFirstSearch");
+    if(u.isGameOver()){ found = true; return F; }
+
+    stats.updateOpen(path.size());
+
+    vector<Move> moves;
+    {
+        vector<Move> all = expand(u);
+        for(const Move &m: all) {
+            GameboardModel v = u;
+            v.move(m);
+            SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+            if(!path.count(v)) moves.push_back(m);
+            else               ++stats.duplicates;
+        }
+    }
+    vector<heuristic_t> scores(moves.size());
+    evaluate(*h, u, moves, scores.data());
+    vector<Child> children;
+    for(size_t i = 0; i < moves.size(); ++i) {
+        const heuristic_t fv = static_cast<double>(g+1) + scores[i];
+        // If u was already expanded before, its children inherit its backed-up value
+        children.push_back(Child{fv, (fu < F ? max(fv, F) : fv), moves[i]});
+    }
+    if(children.empty()) return Heuristic::INF;
+
+    while(true) {
+        stable_sort(children.begin(), children.end());
+        Child &best = children[0];
+        if(best.F > bound || best.F >= Heuristic::INF) return best.F;
+        heuristic_t alternative = (children.size() > 1 ? children[1].F : Heuristic::INF);
+
+        GameboardModel v = u;
+        v.move(best.move);
+        path.insert(v);
+        solution.push_back(best.move);
+        best.F = rbfs(v, g+1, best.f, best.F, min(bound, alternative), found);
+        if(found) return best.F;
+        solution.pop_back();
+        path.erase(v);
+    }
+}
+
+void RecursiveBestFirstSearch::initialize(const GameboardModel &gameboard) {
+    checkSolvable(gameboard, "RecursiveBestFirstSearch");
+    solution.clear();
+    path.clear();
+
+    path.insert(gameboard);
+    bool found = false;
+    const heuristic_t f0 = evaluate(*h, gameboard);
+    rbfs(gameboard, 0, f0, f0, Heuristic::INF, found);
+    path.clear();
+
+    if(!found) throw failed_to_find_solution("RecursiveBestFirstSearch");
+}
+
+GameboardModel::Move RecursiveBestFirstSearch::next() {
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+bool RecursiveBestFirstSearch::isOptimal() const {
+    return h->isAdmissible();
+}
+
+RecursiveBestFirstSearch::~RecursiveBestFirstSearch() {
+    delete h;
+}
@@ -0,0 +1,114 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/ReplanningSearch.h"
+
+#include <queue>
+#include <vector>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+ReplanningSearch::ReplanningSearch(SearchStrategy *searchStrategy, size_t budget):
+    search(searchStrategy),
+    repairBudget(budget)
+{
+}
+
+bool ReplanningSearch::repair(const GameboardModel &src) {
+    CountedMap<GameboardModel, Move> prev(memory);
+    queue<GameboardModel, CountedDeque<GameboardModel> > q{CountedDeque<GameboardModel>(memory)};
+    prev.emplace(src, Move(0, 0));
+    q.push(src);
+    while(!q.empty() && prev.size() < repairBudget) {
+        checkCancelled("ReplanningSearch");
+        const GameboardModel u = q.front(); q.pop();
+        vector<Move> moves = expand(u);
+        for(const Move &m: moves) {
+            GameboardModel v = u;
+            v.move(m);
+            SearchStatistics::Timer timer(stats, &SearchStatistics::lookupTime);
+            if(prev.count(v)){ ++stats.duplicates; continue; }
+            if(plan.count(v)) {
+                // Add path from src to v to the plan
+                GameboardModel w = u;
+                Move mw = m;
+                while(true) {
+                    plan.insert_or_assign(w, mw);
+                    if(w == src) break;
+                    mw = prev.at(w);
+                    w.reverseMove(mw);
+                }
+                return true;
+            }
+            prev.emplace(v, m);
+            q.push(v);
+        }
+        stats.updateOpen(q.size());
+    }
+    return false;
+}
+
+void ReplanningSearch::initialize(const GameboardModel &gameboard) {
+    current = gameboard;
+    if(gameboard.isGameOver() || plan.count(gameboard)) return;
+    if(!plan.empty() && repair(gameboard)) return;
+
+    // Plan from scratch
+    checkSolvable(gameboard, "ReplanningSearch");
+    plan.clear();
+    search->initialize(gameboard);
+    GameboardModel v = gameboard;
+    while(!v.isGameOver()) {
+        checkCancelled("ReplanningSearch");
+        const Move m = search->next();
+        plan.insert_or_assign(v, m);
+        v.move(m);
+    }
+}
+
+GameboardModel::Move ReplanningSearch::next() {
+    auto it = plan.find(current);
+    if(it == plan.end()) return Move(0, 0);
+    const Move ret = it->second;
+    current.move(ret);
+    return ret;
+}
+
+bool ReplanningSearch::plansWhilePlaying() const {
+    return search->plansWhilePlaying();
+}
+
+void ReplanningSearch::cancel() {
+    SearchStrategy::cancel();
+    search->cancel();
+}
+
+void ReplanningSearch::resetCancel() {
+    SearchStrategy::resetCancel();
+    search->resetCancel();
+}
+
+size_t ReplanningSearch::getMemory() const {
+    return SearchStrategy::getMemory() + search->getMemory();
+}
+
+void ReplanningSearch::resetMemoryPeak() {
+    SearchStrategy::resetMemoryPeak();
+    search->resetMemoryPeak();
+}
+
+SearchStatistics ReplanningSearch::getStatistics() const {
+    SearchStatistics ret = SearchStrategy::getStatistics();
+    ret += search->getStatistics();
+    return ret;
+}
+
+void ReplanningSearch::resetStatistics(bool timing) {
+    SearchStrategy::resetStatistics(timing);
+    search->resetStatistics(timing);
+}
+
+ReplanningSearch::~ReplanningSearch() {
+    delete search;
+}
@@ -0,0 +1,149 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/RolloutSearch.h"
+#include "algorithm/DeadlockDetector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+
+using namespace std;
+using Move = GameboardModel::Move;
+using hrc = chrono::high_resolution_clock;
+
+RolloutSearch::RolloutSearch(const Heuristic *heuristic, size_t rollouts, size_t steps, double T, unsigned s,
+                             size_t threads, long deadlineMs):
+    h(heuristic),
+    nRollouts(rollouts),
+    maxSteps(steps),
+    temperature(max(T, 0.0)),
+    seed(s),
+    nThreads(threads != 0 ? threads : max(1u, thread::hardware_concurrency())),
+    deadline(deadlineMs)
+{
+}
+
+bool RolloutSearch::rollout(const GameboardModel &src, size_t i, vector<Move> &path, SearchStatistics &s) const {
+    seed_seq seq{seed, static_cast<unsigned>(i), static_cast<unsigned>(uint64_t(i) >> 32)};
+    mt19937_64 rng(seq);
+
+    path.clear();
+    GameboardModel u = src;
+    // Visited states are kept packed, as tubes are much larger than their contents
+    CountedString key(u.packedSize(), '\0', memory);
+    auto pack = [&u, &key]() -> const CountedString& {
+        u.pack(reinterpret_cast<uint8_t*>(&key[0]));
+        return key;
+    };
+    CountedUnorderedSet<CountedString> visited(memory);
+    visited.insert(pack());
+    vector<Move> candidates;
+    vector<Heuristic::heuristic_t> scores;
+    vector<double> weights;
+    for(size_t steps = 0; !u.isGameOver(); ++steps) {
+        if(steps >= maxSteps || isCancelled()) return false;
+
+        vector<Move> moves;
+        {
+            SearchStatistics::Timer timer(s, &SearchStatistics::moveTime);
+            moves = u.getAllMoves();
+        }
+        ++s.expanded;
+        s.generated += moves.size();
+        candidates.clear();
+        for(const Move &m: moves) {
+            u.move(m);
+            bool seen;
+            {
+                SearchStatistics::Timer timer(s, &SearchStatistics::lookupTime);
+                seen = visited.count(pack()) > 0;
+            }
+            if(seen) ++s.duplicates;
+            else if(!DeadlockDetector::isDead(u)) candidates.push_back(m);
+            u.reverseMove(m);
+        }
+        if(candidates.empty()) {
+            if(path.empty()) return false;
+            u.reverseMove(path.back());
+            path.pop_back();
+            continue;
+        }
+
+        scores.resize(candidates.size());
+        {
+            SearchStatistics::Timer timer(s, &SearchStatistics::heuristicTime);
+            h->evaluateMoves(u, candidates, scores.data());
+        }
+        s.heuristicEvaluations += candidates.size();
+        const Heuristic::heuristic_t best = *min_element(scores.begin(), scores.end());
+        weights.resize(candidates.size());
+        for(size_t k = 0; k < candidates.size(); ++k) {
+            if(temperature <= 0.0) weights[k] = (scores[k] <= best ? 1.0 : 0.0);
+            else                   weights[k] = exp(-(scores[k] - best)/temperature);
+        }
+        discrete_distribution<size_t> choose(weights.begin(), weights.end());
+        const Move &m = candidates[choose(rng)];
+
+        u.move(m);
+        visited.insert(pack());
+        path.push_back(m);
+        s.updateOpen(path.size());
+    }
+    return true;
+}
+
+void RolloutSearch::initialize(const GameboardModel &gameboard) {
+    checkSolvable(gameboard, "RolloutSearch");
+    const hrc::time_point begin = hrc::now();
+    auto expired = [this, &begin](){
+        return deadline.count() > 0 && hrc::now() - begin >= deadline;
+    };
+
+    solution.clear();
+    if(gameboard.isGameOver()) return;
+
+    mutex m;
+    atomic<size_t> nextRollout(0);
+    size_t bestIndex = SIZE_MAX;
+    vector<Move> bestPath;
+
+    auto worker = [&](){
+        vector<Move> path;
+        SearchStatistics s;
+        s.timing = stats.timing;
+        for(size_t i = nextRollout++; i < nRollouts && !expired() && !isCancelled(); i = nextRollout++) {
+            if(!rollout(gameboard, i, path, s)) continue;
+            lock_guard<mutex> lock(m);
+            if(bestIndex == SIZE_MAX || path.size() < bestPath.size() ||
+               (path.size() == bestPath.size() && i < bestIndex)) {
+                bestIndex = i;
+                bestPath = path;
+            }
+        }
+        lock_guard<mutex> lock(m);
+        stats += s;
+    };
+
+    vector<thread> threads;
+    for(size_t t = 1; t < nThreads; ++t) threads.emplace_back(worker);
+    worker();
+    for(thread &t: threads) t.join();
+    checkCancelled("RolloutSearch");
+
+    if(bestIndex == SIZE_MAX) throw failed_to_find_solution("RolloutSearch");
+    solution.assign(bestPath.begin(), bestPath.end());
+}
+
+GameboardModel::Move RolloutSearch::next() {
+    if(solution.empty()) return Move(0, 0);
+    Move ret = solution.front(); solution.pop_front();
+    return ret;
+}
+
+RolloutSearch::~RolloutSearch() {
+    delete h;
+}
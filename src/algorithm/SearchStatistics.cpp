@@ -0,0 +1,83 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/SearchStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+using hrc = chrono::steady_clock;
+
+SearchStatistics::Timer::Timer(SearchStatistics &stats, chrono::nanoseconds SearchStatistics::*phase):
+    total(stats.timing ? &(stats.*phase) : nullptr)
+{
+    if(total != nullptr) begin = hrc::now();
+}
+
+SearchStatistics::Timer::~Timer() {
+    if(total != nullptr) *total += chrono::duration_cast<chrono::nanoseconds>(hrc::now() - begin);
+}
+
+void SearchStatistics::updateOpen(size_t size) {
+    maxOpen = max(maxOpen, size);
+}
+
+SearchStatistics &SearchStatistics::operator+=(const SearchStatistics &s) {
+    expanded             += s.expanded;
+    generated            += s.generated;
+    duplicates           += s.duplicates;
+    reopened             += s.reopened;
+    maxOpen               = max(maxOpen, s.maxOpen);
+    heuristicEvaluations += s.heuristicEvaluations;
+    moveTime             += s.moveTime;
+    heuristicTime        += s.heuristicTime;
+    lookupTime           += s.lookupTime;
+    return *this;
+}
+
+double SearchStatistics::getEffectiveBranchingFactor(size_t depth) const {
+    if(depth == 0) return 0.0;
+    const double N = static_cast<double>(generated);
+    auto treeSize = [depth](double b) {
+        double ret = 0.0, p = 1.0;
+        for(size_t i = 0; i < depth && ret <= 1e300; ++i){ p *= b; ret += p; }
+        return ret;
+    };
+    double lo = 0.0, hi = max(1.0, N);
+    for(int i = 0; i < 100; ++i) {
+        const double mid = (lo + hi) / 2.0;
+        (treeSize(mid) < N ? lo : hi) = mid;
+    }
+    return (lo + hi) / 2.0;
+}
+
+string SearchStatistics::csvHeader() {
+    return "expanded,generated,duplicates,reopened,maxOpen,hEvals,ebf,move_ns,h_ns,lookup_ns";
+}
+
+string SearchStatistics::toCsv(size_t depth) const {
+    char ebf[32];
+    snprintf(ebf, sizeof(ebf), "%.4f", getEffectiveBranchingFactor(depth));
+    return to_string(expanded) + "," + to_string(generated) + "," + to_string(duplicates) + "," +
+           to_string(reopened) + "," + to_string(maxOpen) + "," + to_string(heuristicEvaluations) + "," + ebf + "," +
+           to_string(moveTime.count()) + "," + to_string(heuristicTime.count()) + "," + to_string(lookupTime.count());
+}
+
+string SearchStatistics::toJson(size_t depth) const {
+    char ebf[32];
+    snprintf(ebf, sizeof(ebf), "%.4f", getEffectiveBranchingFactor(depth));
+    return string("{") +
+        "\"expanded\":"             + to_string(expanded)               + "," +
+        "\"generated\":"            + to_string(generated)              + "," +
+        "\"duplicates\":"           + to_string(duplicates)             + "," +
+        "\"reopened\":"             + to_string(reopened)               + "," +
+        "\"maxOpen\":"              + to_string(maxOpen)                + "," +
+        "\"heuristicEvaluations\":" + to_string(heuristicEvaluations)   + "," +
+        "\"effectiveBranchingFactor\":" + ebf                           + "," +
+        "\"moveTime_ns\":"          + to_string(moveTime.count())       + "," +
+        "\"heuristicTime_ns\":"     + to_string(heuristicTime.count())  + "," +
+        "\"lookupTime_ns\":"        + to_string(lookupTime.count())     +
+        "}";
+}
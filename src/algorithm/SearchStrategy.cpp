@@ -2,46 +2,80 @@
 // Distributed under the terms of the GNU General Public License, version 3
 
 #include "algorithm/SearchStrategy.h"
-
-#include <cstdlib>
-#include <cstdio>
-#include <cstring>
+#include "algorithm/DeadlockDetector.h"
 
 using namespace std;
 
-long parseLine(char* line){
-    // This assumes that a digit will be found and the line ends in " Kb".
-    long i = strlen(line);
-    const char* p = line;
-    while (*p <'0' || *p > '9') p++;
-    line[i-3] = '\0';
-    i = atol(p);
-    return i;
+SearchStrategy::failed_to_find_solution::failed_to_find_solution(const std::string &s) :
+    logic_error(s)
+{
 }
 
-long getValue(){
-    FILE* file = fopen("/proc/self/status", "r");
-    long result = -1;
-    char line[128];
+void SearchStrategy::checkSolvable(const GameboardModel &gameboard, const std::string &strategyName) {
+    if(DeadlockDetector().analyse(gameboard) == DeadlockDetector::DEAD)
+        throw failed_to_find_solution(strategyName + ": gameboard is unsolvable");
+}
 
-    while (fgets(line, 128, file) != nullptr){
-        if (strncmp(line, "VmPeak:", 7) == 0){
-            result = parseLine(line);
-            break;
-        }
-    }
-    fclose(file);
-    if(result != -1) result *= 1000; // kB to B
-    return result;
+void SearchStrategy::checkCancelled(const std::string &strategyName) const {
+    if(cancelled.load(memory_order_relaxed)) throw failed_to_find_solution(strategyName + ": cancelled");
 }
 
-SearchStrategy::failed_to_find_solution::failed_to_find_solution(const std::string &s) :
-    logic_error(s)
-{
+void SearchStrategy::cancel() {
+    cancelled = true;
+}
+
+void SearchStrategy::resetCancel() {
+    cancelled = false;
+}
+
+bool SearchStrategy::isCancelled() const {
+    return cancelled;
+}
+
+bool SearchStrategy::isOptimal() const {
+    return false;
+}
+
+bool SearchStrategy::plansWhilePlaying() const {
+    return false;
 }
 
 SearchStrategy::~SearchStrategy() = default;
 
 size_t SearchStrategy::getMemory() const {
-    return static_cast<size_t>(getValue());
+    return memory.getPeak();
+}
+
+void SearchStrategy::resetMemoryPeak() {
+    memory.resetPeak();
+}
+
+vector<GameboardModel::Move> SearchStrategy::expand(const GameboardModel &u) const {
+    SearchStatistics::Timer timer(stats, &SearchStatistics::moveTime);
+    vector<GameboardModel::Move> ret = u.getAllMoves();
+    ++stats.expanded;
+    stats.generated += ret.size();
+    return ret;
+}
+
+Heuristic::heuristic_t SearchStrategy::evaluate(const Heuristic &h, const GameboardModel &g) const {
+    SearchStatistics::Timer timer(stats, &SearchStatistics::heuristicTime);
+    ++stats.heuristicEvaluations;
+    return h(g);
+}
+
+void SearchStrategy::evaluate(const Heuristic &h, const GameboardModel &parent,
+                              const vector<GameboardModel::Move> &moves, Heuristic::heuristic_t *out) const {
+    SearchStatistics::Timer timer(stats, &SearchStatistics::heuristicTime);
+    stats.heuristicEvaluations += moves.size();
+    h.evaluateMoves(parent, moves, out);
+}
+
+SearchStatistics SearchStrategy::getStatistics() const {
+    return stats;
+}
+
+void SearchStrategy::resetStatistics(bool timing) {
+    stats = SearchStatistics();
+    stats.timing = timing;
 }
@@ -0,0 +1,181 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/SolutionCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+namespace {
+    const char MAGIC[8] = {'B', 'S', 'S', 'O', 'L', 0, 0, 1};
+
+    uint64_t hashBytes(uint64_t h, const uint8_t *s, size_t n) {
+        for(size_t i = 0; i < n; ++i) h = (h ^ s[i]) * 0x100000001b3ull;
+        return h;
+    }
+
+    uint64_t mix(uint64_t h) {
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        return h ^ (h >> 31);
+    }
+
+    uint32_t movesLeft(const SolutionCache::Record &r) {
+        return r.remaining & ~SolutionCache::OPTIMAL;
+    }
+
+    bool isOptimal(const SolutionCache::Record &r) {
+        return (r.remaining & SolutionCache::OPTIMAL) != 0;
+    }
+
+    /**
+     * @brief Check if record a is to replace record b of the same state.
+     */
+    bool isBetter(const SolutionCache::Record &a, const SolutionCache::Record &b) {
+        if(isOptimal(a) != isOptimal(b)) return isOptimal(a);
+        return movesLeft(a) < movesLeft(b);
+    }
+}
+
+SolutionCache::SolutionCache(const string &path) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if(fd < 0) fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return;
+    load();
+}
+
+shared_ptr<SolutionCache> SolutionCache::open(const string &path) {
+    static mutex mtx;
+    static map<string, weak_ptr<SolutionCache> > instances;
+
+    lock_guard<mutex> lock(mtx);
+    shared_ptr<SolutionCache> ret = instances[path].lock();
+    if(ret == nullptr) {
+        ret = make_shared<SolutionCache>(path);
+        instances[path] = ret;
+    }
+    return ret;
+}
+
+void SolutionCache::load() {
+    struct stat st{};
+    if(fstat(fd, &st) != 0) return;
+    const size_t sz = static_cast<size_t>(st.st_size);
+    if(sz == 0) {
+        if(write(fd, MAGIC, sizeof(MAGIC)) != sizeof(MAGIC)){ close(fd); fd = -1; }
+        return;
+    }
+    if(sz < sizeof(MAGIC)){ close(fd); fd = -1; return; }
+
+    void *p = mmap(nullptr, sz, PROT_READ, MAP_SHARED, fd, 0);
+    if(p == MAP_FAILED){ close(fd); fd = -1; return; }
+    if(memcmp(p, MAGIC, sizeof(MAGIC)) != 0) {
+        // Not a cache file; do not touch it
+        munmap(p, sz); close(fd); fd = -1;
+        return;
+    }
+    // A partial record at the end (from an interrupted write) is ignored
+    const size_t n = (sz - sizeof(MAGIC)) / sizeof(Record);
+    const Record *records = reinterpret_cast<const Record*>(static_cast<const char*>(p) + sizeof(MAGIC));
+    index.reserve(n);
+    for(size_t i = 0; i < n; ++i) {
+        auto it = index.find(records[i].key);
+        if(it == index.end())                       index.emplace(records[i].key, records[i]);
+        else if(isBetter(records[i], it->second))   it->second = records[i];
+    }
+    munmap(p, sz);
+}
+
+uint64_t SolutionCache::canonicalize(const GameboardModel &g, vector<size_t> &canonicalIndex) {
+    const size_t N = g.size(), H = g.tubeHeight();
+    vector<uint8_t> packed(g.packedSize());
+    g.pack(packed.data());
+
+    vector<size_t> order(N);
+    for(size_t i = 0; i < N; ++i) order[i] = i;
+    stable_sort(order.begin(), order.end(), [&packed, H](size_t a, size_t b){
+        return memcmp(&packed[a*H], &packed[b*H], H) < 0;
+    });
+
+    canonicalIndex.resize(N);
+    uint64_t h = 0xcbf29ce484222325ull ^ (uint64_t(N) << 32) ^ H;
+    for(size_t c = 0; c < N; ++c) {
+        canonicalIndex[order[c]] = c;
+        h = hashBytes(h, &packed[order[c]*H], H);
+    }
+    return mix(h);
+}
+
+bool SolutionCache::lookup(const GameboardModel &gameboard, vector<Move> &moves, bool requireOptimal) const {
+    moves.clear();
+    GameboardModel g = gameboard;
+    vector<size_t> canonicalIndex;
+    vector<size_t> tubeOf;
+    uint32_t remaining = UINT32_MAX;
+
+    lock_guard<mutex> lock(m);
+    while(!g.isGameOver()) {
+        const uint64_t key = canonicalize(g, canonicalIndex);
+        auto it = index.find(key);
+        if(it == index.end()) return false;
+        const Record &r = it->second;
+        // An optimal record is only replaced by another optimal one, so the rest of the chain is optimal as well
+        if(requireOptimal && moves.empty() && !isOptimal(r)) return false;
+        // Remaining moves must decrease, and the move must be valid; otherwise, this is a hash collision
+        if(movesLeft(r) >= remaining || r.from >= g.size() || r.to >= g.size()) return false;
+        remaining = movesLeft(r);
+
+        tubeOf.resize(g.size());
+        for(size_t i = 0; i < g.size(); ++i) tubeOf[canonicalIndex[i]] = i;
+        const Move mv(tubeOf[r.from], tubeOf[r.to]);
+        if(!g.canMove(mv)) return false;
+        g.move(mv);
+        moves.push_back(mv);
+    }
+    return true;
+}
+
+void SolutionCache::store(const GameboardModel &gameboard, const vector<Move> &moves, bool optimal) {
+    GameboardModel g = gameboard;
+    vector<size_t> canonicalIndex;
+    vector<Record> records;
+
+    lock_guard<mutex> lock(m);
+    for(size_t j = 0; j < moves.size(); ++j) {
+        const uint64_t key = canonicalize(g, canonicalIndex);
+        const Record r{key, uint16_t(canonicalIndex[moves[j].from]), uint16_t(canonicalIndex[moves[j].to]),
+                       uint32_t(moves.size() - j) | (optimal ? OPTIMAL : 0)};
+        auto it = index.find(key);
+        if(it == index.end() || isBetter(r, it->second)) {
+            index[key] = r;
+            records.push_back(r);
+        }
+        g.move(moves[j]);
+    }
+
+    if(fd < 0 || records.empty()) return;
+    const size_t bytes = records.size() * sizeof(Record);
+    if(write(fd, records.data(), bytes) != static_cast<ssize_t>(bytes)) {
+        // Keep working in memory only
+        close(fd);
+        fd = -1;
+    }
+}
+
+size_t SolutionCache::size() const {
+    lock_guard<mutex> lock(m);
+    return index.size();
+}
+
+SolutionCache::~SolutionCache() {
+    if(fd >= 0) close(fd);
+}
@@ -6,6 +6,33 @@
 #include "algorithm/heuristics/AdmissibleHeuristic.h"
 
 using namespace std;
+using Move = GameboardModel::Move;
+
+namespace {
+    /**
+     * @brief What the heuristic needs to know about a tube.
+     */
+    struct TubeInfo {
+        size_t size;
+        color_t bottom;
+        size_t run;     ///< @brief Number of contiguous, same-color pieces at the bottom.
+    };
+
+    /**
+     * @brief Contribution of color c to the second part, with tubes from and to replaced by f and t.
+     */
+    size_t colorPenalty(const vector<TubeInfo> &tubes, color_t c, size_t from, const TubeInfo &f, size_t to,
+                        const TubeInfo &t) {
+        size_t sum = 0, mx = 0;
+        for(size_t i = 0; i < tubes.size(); ++i) {
+            const TubeInfo &u = (i == from ? f : i == to ? t : tubes[i]);
+            if(u.size == 0 || u.bottom != c) continue;
+            sum += u.run;
+            mx = max(mx, u.run);
+        }
+        return sum - mx;
+    }
+}
 
 Heuristic::heuristic_t AdmissibleHeuristic::operator()(const GameboardModel &gameboard) const {
     double ret = 0.0;
@@ -38,3 +65,54 @@ Heuristic::heuristic_t AdmissibleHeuristic::operator()(const GameboardModel &gam
 
     return ret;
 }
+
+void AdmissibleHeuristic::evaluateMoves(const GameboardModel &parent, const vector<Move> &moves,
+                                        heuristic_t *out) const {
+    const size_t n = parent.size();
+    vector<TubeInfo> tubes(n);
+    size_t first = 0;
+    for(size_t i = 0; i < n; ++i) {
+        const Tube &t = parent[i];
+        TubeInfo &u = tubes[i];
+        u.size = t.size();
+        u.bottom = (t.empty() ? 0 : t[0]);
+        for(u.run = 0; u.run < u.size && t[u.run] == u.bottom; ++u.run);
+        first += u.size - u.run;
+    }
+    const size_t nColors = parent.getNumberOfColors();
+    vector<size_t> penalty(nColors);
+    size_t second = 0;
+    for(color_t c = 0; c < nColors; ++c) {
+        penalty[c] = colorPenalty(tubes, c, n, tubes[0], n, tubes[0]);
+        second += penalty[c];
+    }
+
+    for(size_t k = 0; k < moves.size(); ++k) {
+        const Move &m = moves[k];
+        const TubeInfo &f = tubes[m.from], &t = tubes[m.to];
+        const color_t x = parent[m.from].back();
+
+        TubeInfo nf{f.size - 1, f.bottom, min(f.run, f.size - 1)};
+        TubeInfo nt{t.size + 1, t.bottom, t.run};
+        if(t.size == 0)                                  nt = TubeInfo{1, x, 1};
+        else if(t.run == t.size && x == t.bottom) ++nt.run;
+
+        const size_t p1 = first - (f.size - f.run) - (t.size - t.run) + (nf.size - nf.run) + (nt.size - nt.run);
+
+        color_t affected[3] = {x, f.bottom, t.bottom};
+        size_t nAffected = 1;
+        if(f.bottom != x) affected[nAffected++] = f.bottom;
+        if(t.size > 0 && t.bottom != x && t.bottom != f.bottom) affected[nAffected++] = t.bottom;
+        size_t p2 = second;
+        for(size_t i = 0; i < nAffected; ++i) {
+            const color_t c = affected[i];
+            p2 = p2 - penalty[c] + colorPenalty(tubes, c, m.from, nf, m.to, nt);
+        }
+
+        out[k] = static_cast<heuristic_t>(p1) + static_cast<heuristic_t>(p2);
+    }
+}
+
+bool AdmissibleHeuristic::isAdmissible() const {
+    return true;
+}
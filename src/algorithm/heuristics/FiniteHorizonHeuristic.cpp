@@ -3,6 +3,8 @@
 
 #include "algorithm/heuristics/FiniteHorizonHeuristic.h"
 
+#include <algorithm>
+
 using namespace std;
 
 FiniteHorizonHeuristic::FiniteHorizonHeuristic(const Heuristic *baseHeuristic, size_t horizon):
@@ -14,12 +16,11 @@ FiniteHorizonHeuristic::FiniteHorizonHeuristic(const Heuristic *baseHeuristic, s
 
 Heuristic::heuristic_t FiniteHorizonHeuristic::operator()(const GameboardModel &gameboard) const {
     if(gameboard.isGameOver()) return 0.0;
-    vector<GameboardModel> adj = gameboard.getAdjacentStates();
+    vector<GameboardModel::Move> moves = gameboard.getAllMoves();
+    vector<heuristic_t> scores(moves.size());
+    h->evaluateMoves(gameboard, moves, scores.data());
     Heuristic::heuristic_t best = INF;
-    for(const GameboardModel &g: adj) {
-        best = min(best, (*h)(g));
-        if(best <= 0.0) return best+1;
-    }
+    for(const heuristic_t &s: scores) best = min(best, s);
     return best+1;
 }
 
@@ -3,4 +3,20 @@
 
 #include "algorithm/heuristics/Heuristic.h"
 
+using namespace std;
+using Move = GameboardModel::Move;
+
+void Heuristic::evaluateMoves(const GameboardModel &parent, const vector<Move> &moves, heuristic_t *out) const {
+    GameboardModel v = parent;
+    for(size_t i = 0; i < moves.size(); ++i) {
+        v.move(moves[i]);
+        out[i] = (*this)(v);
+        v.reverseMove(moves[i]);
+    }
+}
+
+bool Heuristic::isAdmissible() const {
+    return false;
+}
+
 Heuristic::~Heuristic() = default;
@@ -6,6 +6,7 @@
 #include "algorithm/heuristics/NonAdmissibleHeuristic.h"
 
 using namespace std;
+using Move = GameboardModel::Move;
 
 NonAdmissibleHeuristic::NonAdmissibleHeuristic(const Heuristic *heuristic, double factor):
     h(heuristic),
@@ -17,6 +18,12 @@ Heuristic::heuristic_t NonAdmissibleHeuristic::operator()(const GameboardModel &
     return (*h)(gameboard)*f;
 }
 
+void NonAdmissibleHeuristic::evaluateMoves(const GameboardModel &parent, const vector<Move> &moves,
+                                           heuristic_t *out) const {
+    h->evaluateMoves(parent, moves, out);
+    for(size_t i = 0; i < moves.size(); ++i) out[i] *= f;
+}
+
 NonAdmissibleHeuristic::~NonAdmissibleHeuristic() {
     delete h;
 }
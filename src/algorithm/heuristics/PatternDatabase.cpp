@@ -0,0 +1,266 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/heuristics/PatternDatabase.h"
+#include "model/PackedBoard.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const char MAGIC[8] = {'B', 'S', 'P', 'D', 'B', 0, 0, 1};
+
+    /**
+     * @brief Header of a pattern database file; it is followed by the slots of the hash table.
+     */
+    struct Header {
+        char magic[8];
+        uint32_t nTubes;
+        uint32_t tubeH;
+        uint32_t nColors;
+        uint32_t additive;
+        uint64_t pattern;       ///< @brief Bitmask of colors in the pattern.
+        uint64_t capacity;      ///< @brief Number of slots (a power of 2).
+        uint64_t count;         ///< @brief Number of abstract states.
+    };
+
+    uint64_t hashBytes(const uint8_t *s, size_t n) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for(size_t i = 0; i < n; ++i) h = (h ^ s[i]) * 0x100000001b3ull;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        return h ^ (h >> 31);
+    }
+
+    /**
+     * @brief 56-bit, nonzero key of a state.
+     */
+    uint64_t keyOf(uint64_t h) {
+        return (h >> 8) | (uint64_t(1) << 55);
+    }
+
+    /**
+     * @brief Sort the tubes of an abstract state, in place.
+     */
+    void canonicalize(uint8_t *s, size_t nTubes, size_t H) {
+        for(size_t i = 1; i < nTubes; ++i)
+            for(size_t j = i; j > 0 && memcmp(s + (j-1)*H, s + j*H, H) > 0; --j)
+                swap_ranges(s + (j-1)*H, s + j*H, s + j*H);
+    }
+
+    uint64_t patternMask(const vector<color_t> &pattern) {
+        uint64_t ret = 0;
+        for(const color_t &c: pattern) ret |= uint64_t(1) << c;
+        return ret;
+    }
+}
+
+PatternDatabase::PatternDatabase(const string &path, size_t num_tubes, size_t tube_height, size_t num_colors,
+                                 const vector<color_t> &pat, bool add):
+    nTubes(num_tubes),
+    tubeH(tube_height),
+    nColors(num_colors),
+    pattern(pat),
+    additive(add)
+{
+    if(pattern.empty()) throw invalid_argument("empty pattern");
+    if(nColors > nTubes || nColors >= 64 || pattern.size() + 1 >= UNREACHABLE)
+        throw invalid_argument("invalid number of colors");
+    sort(pattern.begin(), pattern.end());
+    pattern.erase(unique(pattern.begin(), pattern.end()), pattern.end());
+
+    symbols.assign(nColors, uint8_t(pattern.size() + 1));
+    for(size_t i = 0; i < pattern.size(); ++i) {
+        if(pattern[i] >= nColors) throw invalid_argument("color " + to_string(pattern[i]) + " does not exist");
+        symbols[pattern[i]] = uint8_t(i + 1);
+    }
+
+    if(!load(path)) {
+        build(path);
+        if(!load(path)) throw runtime_error("failed to load pattern database " + path);
+    }
+}
+
+shared_ptr<const PatternDatabase> PatternDatabase::open(const string &path, size_t nTubes, size_t tubeH,
+                                                        size_t nColors, const vector<color_t> &pattern,
+                                                        bool additive) {
+    static mutex m;
+    static map<string, weak_ptr<const PatternDatabase> > instances;
+
+    lock_guard<mutex> lock(m);
+    shared_ptr<const PatternDatabase> ret = instances[path].lock();
+    if(ret == nullptr ||
+       ret->nTubes != nTubes || ret->tubeH != tubeH || ret->nColors != nColors ||
+       patternMask(ret->pattern) != patternMask(pattern) || ret->additive != additive) {
+        ret = make_shared<const PatternDatabase>(path, nTubes, tubeH, nColors, pattern, additive);
+        instances[path] = ret;
+    }
+    return ret;
+}
+
+bool PatternDatabase::load(const string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat st{};
+    if(fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) { close(fd); return false; }
+    void *p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED) return false;
+
+    const Header *header = static_cast<const Header*>(p);
+    const size_t expectedSize = sizeof(Header) + header->capacity * sizeof(uint64_t);
+    if(memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+       header->nTubes != nTubes || header->tubeH != tubeH || header->nColors != nColors ||
+       header->additive != uint32_t(additive) || header->pattern != patternMask(pattern) ||
+       static_cast<size_t>(st.st_size) != expectedSize) {
+        munmap(p, static_cast<size_t>(st.st_size));
+        return false;
+    }
+
+    data = p;
+    dataSize = static_cast<size_t>(st.st_size);
+    slots = reinterpret_cast<const uint64_t*>(static_cast<const char*>(p) + sizeof(Header));
+    mask = header->capacity - 1;
+    return true;
+}
+
+void PatternDatabase::build(const string &path) const {
+    const size_t R = abstractSize();
+    const uint8_t P = uint8_t(pattern.size());
+
+    // Backward search from the (canonical) abstract goal
+    unordered_map<string, uint8_t> dist;
+    {
+        string goal(R, '\0');
+        size_t t = 0;
+        for(uint8_t p = 1; p <= P; ++p, ++t)             fill(&goal[t*tubeH], &goal[t*tubeH] + tubeH, char(p));
+        for(size_t w = P; w < nColors; ++w, ++t)         fill(&goal[t*tubeH], &goal[t*tubeH] + tubeH, char(P+1));
+        canonicalize(reinterpret_cast<uint8_t*>(&goal[0]), nTubes, tubeH);
+
+        deque< pair<string, uint8_t> > q;
+        dist.emplace(goal, 0);
+        q.emplace_back(goal, 0);
+        PackedBoard b(nTubes, tubeH);
+        while(!q.empty()) {
+            const string s = q.front().first;
+            const uint8_t d = q.front().second;
+            q.pop_front();
+            if(dist.at(s) < d) continue;
+
+            b.load(reinterpret_cast<const uint8_t*>(s.data()));
+            for(size_t from = 0; from < nTubes; ++from) {
+                const size_t szFrom = b.getSize(from);
+                if(szFrom >= tubeH) continue;
+                for(size_t to = 0; to < nTubes; ++to) {
+                    const size_t szTo = b.getSize(to);
+                    if(to == from || szTo == 0) continue;
+                    const char x = char(b.getTop(to));
+                    if(szTo > 1 && s[to*tubeH + szTo - 2] != x) continue;
+
+                    string u = s;
+                    u[to*tubeH + szTo - 1] = 0;
+                    u[from*tubeH + szFrom] = x;
+                    canonicalize(reinterpret_cast<uint8_t*>(&u[0]), nTubes, tubeH);
+
+                    const bool free = (additive && uint8_t(x) > P);
+                    const uint8_t nd = uint8_t(min(d + (free ? 0 : 1), UNREACHABLE - 1));
+                    auto it = dist.find(u);
+                    if(it != dist.end() && it->second <= nd) continue;
+                    dist[u] = nd;
+                    if(free) q.emplace_front(u, nd);
+                    else     q.emplace_back (u, nd);
+                }
+            }
+        }
+    }
+
+    // Hash table
+    uint64_t capacity = 64;
+    while(capacity < 2*dist.size()) capacity *= 2;
+    vector<uint64_t> table(capacity, 0);
+    for(const auto &p: dist) {
+        const uint64_t h = hashBytes(reinterpret_cast<const uint8_t*>(p.first.data()), R);
+        const uint64_t key = keyOf(h);
+        for(uint64_t i = h & (capacity-1); ; i = (i+1) & (capacity-1)) {
+            if(table[i] == 0){ table[i] = (key << 8) | p.second; break; }
+            if((table[i] >> 8) == key){ table[i] = (key << 8) | min<uint64_t>(table[i] & 0xFF, p.second); break; }
+        }
+    }
+
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.nTubes   = uint32_t(nTubes);
+    header.tubeH    = uint32_t(tubeH);
+    header.nColors  = uint32_t(nColors);
+    header.additive = uint32_t(additive);
+    header.pattern  = patternMask(pattern);
+    header.capacity = capacity;
+    header.count    = dist.size();
+
+    const string tmp = path + ".tmp" + to_string(getpid());
+    FILE *f = fopen(tmp.c_str(), "wb");
+    if(f == nullptr) throw runtime_error("failed to create pattern database " + path);
+    bool ok = (fwrite(&header, sizeof(header), 1, f) == 1 &&
+               fwrite(table.data(), sizeof(uint64_t), table.size(), f) == table.size());
+    ok = (fclose(f) == 0) && ok;
+    if(!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        remove(tmp.c_str());
+        throw runtime_error("failed to write pattern database " + path);
+    }
+}
+
+size_t PatternDatabase::abstractSize() const {
+    return nTubes * tubeH;
+}
+
+void PatternDatabase::abstract(const GameboardModel &g, uint8_t *out) const {
+    uint8_t *p = out;
+    for(const Tube &t: g) {
+        size_t i = 0;
+        for(; i < t.size(); ++i) p[i] = symbols[t[i]];
+        for(; i < tubeH; ++i) p[i] = 0;
+        p += tubeH;
+    }
+    canonicalize(out, nTubes, tubeH);
+}
+
+uint8_t PatternDatabase::lookup(const uint8_t *canonical) const {
+    const uint64_t h = hashBytes(canonical, abstractSize());
+    const uint64_t key = keyOf(h);
+    for(uint64_t i = h & mask; ; i = (i+1) & mask) {
+        const uint64_t slot = slots[i];
+        if(slot == 0) return UNREACHABLE;
+        if((slot >> 8) == key) return uint8_t(slot & 0xFF);
+    }
+}
+
+uint8_t PatternDatabase::lookup(const GameboardModel &g) const {
+    vector<uint8_t> s(abstractSize());
+    abstract(g, s.data());
+    return lookup(s.data());
+}
+
+const vector<color_t> &PatternDatabase::getPattern() const {
+    return pattern;
+}
+
+bool PatternDatabase::isAdditive() const {
+    return additive;
+}
+
+PatternDatabase::~PatternDatabase() {
+    if(data != nullptr) munmap(data, dataSize);
+}
@@ -0,0 +1,43 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/heuristics/PatternDatabaseHeuristic.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+
+using namespace std;
+
+PatternDatabaseHeuristic::PatternDatabaseHeuristic(const vector< shared_ptr<const PatternDatabase> > &dbs):
+    databases(dbs),
+    additive(!dbs.empty() && dbs.front()->isAdditive())
+{
+    if(databases.empty()) throw invalid_argument("no pattern databases");
+    set<color_t> colors;
+    for(const shared_ptr<const PatternDatabase> &db: databases) {
+        if(db->isAdditive() != additive) throw invalid_argument("cannot mix additive and non-additive databases");
+        if(!additive) continue;
+        for(const color_t &c: db->getPattern())
+            if(!colors.insert(c).second)
+                throw invalid_argument("patterns of additive databases must be disjoint");
+    }
+}
+
+Heuristic::heuristic_t PatternDatabaseHeuristic::operator()(const GameboardModel &g) const {
+    vector<uint8_t> s;
+    heuristic_t ret = 0.0;
+    for(const shared_ptr<const PatternDatabase> &db: databases) {
+        s.resize(db->abstractSize());
+        db->abstract(g, s.data());
+        const uint8_t d = db->lookup(s.data());
+        if(d == PatternDatabase::UNREACHABLE) return INF;
+        if(additive) ret += d;
+        else         ret = max(ret, heuristic_t(d));
+    }
+    return ret;
+}
+
+bool PatternDatabaseHeuristic::isAdmissible() const {
+    return true;
+}
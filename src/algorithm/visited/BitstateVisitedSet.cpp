@@ -0,0 +1,85 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/visited/BitstateVisitedSet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Hash the contents of a gameboard, tube by tube, using a seed.
+     */
+    uint64_t hashState(const GameboardModel &g, uint64_t seed) {
+        uint64_t h = mix(seed ^ g.size());
+        for(const Tube &t: g){
+            for(const color_t &c: t) h = mix(h ^ (c + 1));
+            h = mix(h + 0x9e3779b97f4a7c15ull);
+        }
+        return h;
+    }
+}
+
+BitstateVisitedSet::BitstateVisitedSet(size_t log2Bits, size_t nHashes):
+    k(max(nHashes, size_t(1)))
+{
+    if(log2Bits < 6 || log2Bits > 40) throw invalid_argument("log2Bits must be between 6 and 40");
+    bits.assign((size_t(1) << log2Bits)/64, 0);
+    mask = (uint64_t(1) << log2Bits) - 1;
+}
+
+bool BitstateVisitedSet::contains(const GameboardModel &g) const {
+    const uint64_t h1 = hashState(g, 0), h2 = hashState(g, 1) | 1;
+    for(size_t i = 0; i < k; ++i){
+        uint64_t b = (h1 + i*h2) & mask;
+        if(!(bits[b >> 6] & (uint64_t(1) << (b & 63)))) return false;
+    }
+    return true;
+}
+
+void BitstateVisitedSet::insert(const GameboardModel &g) {
+    const uint64_t h1 = hashState(g, 0), h2 = hashState(g, 1) | 1;
+    bool changed = false;
+    for(size_t i = 0; i < k; ++i){
+        uint64_t b = (h1 + i*h2) & mask;
+        uint64_t &word = bits[b >> 6];
+        const uint64_t bit = uint64_t(1) << (b & 63);
+        if(!(word & bit)){
+            word |= bit;
+            ++nSet;
+            changed = true;
+        }
+    }
+    if(changed) ++nInserted;
+}
+
+void BitstateVisitedSet::erase(const GameboardModel &) {
+}
+
+void BitstateVisitedSet::clear() {
+    fill(bits.begin(), bits.end(), 0);
+    nSet = 0;
+    nInserted = 0;
+}
+
+double BitstateVisitedSet::getOmissionProbability() const {
+    const double f = static_cast<double>(nSet) / static_cast<double>(mask + 1);
+    return pow(f, static_cast<double>(k));
+}
+
+size_t BitstateVisitedSet::getNumberOfInsertions() const {
+    return nInserted;
+}
+
+size_t BitstateVisitedSet::getMemory() const {
+    return bits.size() * sizeof(uint64_t);
+}
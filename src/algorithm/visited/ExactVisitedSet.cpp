@@ -0,0 +1,25 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/visited/ExactVisitedSet.h"
+
+bool ExactVisitedSet::contains(const GameboardModel &g) const {
+    return visited.count(g);
+}
+
+void ExactVisitedSet::insert(const GameboardModel &g) {
+    visited.insert(g);
+}
+
+void ExactVisitedSet::erase(const GameboardModel &g) {
+    visited.erase(g);
+}
+
+void ExactVisitedSet::clear() {
+    visited.clear();
+    memory.resetPeak();
+}
+
+size_t ExactVisitedSet::getMemory() const {
+    return memory.getPeak();
+}
@@ -0,0 +1,6 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "algorithm/visited/VisitedSet.h"
+
+VisitedSet::~VisitedSet() = default;
@@ -10,6 +10,8 @@
 #include "controller/MenuController.h"
 #include "view/MenuView.h"
 #include "algorithm/AstarSearch.h"
+#include "algorithm/RolloutSearch.h"
+#include "algorithm/RealTimeSearch.h"
 
 using namespace std;
 
@@ -29,6 +31,8 @@ State *ChooseHeuristicStrategyState::run() {
     menuModel.addButton(1, "1. Depth first search, greedy first");
     menuModel.addButton(2, "2. Best-first search, greedy");
     menuModel.addButton(3, "3. Best-first search, A*");
+    menuModel.addButton(4, "4. Monte-Carlo rollouts");
+    menuModel.addButton(5, "5. Real-time search, RTAA*");
     menuModel.addButton(0, "0. Back");
 
     MenuView menuView(menuModel);
@@ -52,6 +56,11 @@ State *ChooseHeuristicStrategyState::run() {
             this->setSearchStrategy(new GreedySearch(heuristic)); return State::playMachineState;
         case 3:
             this->setSearchStrategy(new AstarSearch(heuristic)); return State::playMachineState;
+        case 4:
+            this->setSearchStrategy(new RolloutSearch(heuristic, 1000, 1000, 1.0, 0, 0, 5000));
+            return State::playMachineState;
+        case 5:
+            this->setSearchStrategy(new RealTimeSearch(heuristic, 256, 100)); return State::playMachineState;
         case 0: return State::chooseHeuristicState;
         default: throw logic_error("");
     }
@@ -3,6 +3,7 @@
 
 #include "controller/state/ChooseStrategyState.h"
 
+#include "algorithm/CachedSearch.h"
 #include "algorithm/DepthFirstSearch.h"
 #include "algorithm/BreadthFirstSearch.h"
 #include "algorithm/IterativeDeepeningSearch.h"
@@ -16,7 +17,9 @@ ChooseStrategyState::ChooseStrategyState(TerminalGUI *term) : State(term) {
 
 void ChooseStrategyState::setSearchStrategy(SearchStrategy *search) {
     delete this->strategy;
-    this->strategy = search;
+    // Boards solved before are answered from the cache, unless the strategy is meant to plan as it plays
+    if(search->plansWhilePlaying()) this->strategy = search;
+    else this->strategy = new CachedSearch(search, SolutionCache::open(State::solutionCachePath));
 }
 
 SearchStrategy *ChooseStrategyState::getSearchStrategy() const{
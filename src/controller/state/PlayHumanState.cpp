@@ -9,7 +9,10 @@
 #include "view/GameboardView.h"
 #include "view/ScoreboardView.h"
 #include "controller/state/PlayHumanState.h"
+#include "algorithm/BackgroundSolver.h"
+#include "algorithm/CachedSearch.h"
 #include "algorithm/DepthFirstGreedySearch.h"
+#include "algorithm/ReplanningSearch.h"
 #include "algorithm/heuristics/AdmissibleHeuristic.h"
 
 using namespace std;
@@ -27,7 +30,13 @@ State *PlayHumanState::run() {
     GameboardView gameboardView(gameboard);
     ScoreboardView scoreboardView(scoreboard);
 
-    SearchStrategy *search = new DepthFirstGreedySearch(new AdmissibleHeuristic());
+    SearchStrategy *search = new ReplanningSearch(new CachedSearch(
+        new DepthFirstGreedySearch(new AdmissibleHeuristic()),
+        SolutionCache::open(State::solutionCachePath)
+    ));
+    // Hints are computed while the user is thinking
+    BackgroundSolver *solver = new BackgroundSolver(search);
+    solver->submit(gameboard);
 
     int fr, to;
     bool invalidMove = false;
@@ -43,9 +52,14 @@ State *PlayHumanState::run() {
             invalidMove = false;
         }
         if(askedForHint){
-            search->initialize(gameboard);
-            GameboardModel::Move m = search->next();
-            getTerminal()->drawStringAbsolute(pos_t(0, getTerminal()->getSize().y-2), "Asked for a hint. Try " + to_string(m.from) + " " + to_string(m.to));
+            string hint;
+            try {
+                GameboardModel::Move m = solver->next();
+                hint = "Asked for a hint. Try " + to_string(m.from) + " " + to_string(m.to);
+            } catch(const SearchStrategy::failed_to_find_solution &) {
+                hint = "Asked for a hint, but no solution was found";
+            }
+            getTerminal()->drawStringAbsolute(pos_t(0, getTerminal()->getSize().y-2), hint);
             askedForHint = false;
         }
 
@@ -71,11 +85,13 @@ State *PlayHumanState::run() {
         if(gameboard.canMove(move)) {
             gameboard.move(move);
             scoreboard.addScore();
+            solver->submit(gameboard);
         } else {
             invalidMove = true;
         }
     }
 
+    delete solver;
     delete search;
 
     return State::mainMenuState;
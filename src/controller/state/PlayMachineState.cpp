@@ -3,6 +3,8 @@
 
 #include "controller/state/PlayMachineState.h"
 
+#include "algorithm/BackgroundSolver.h"
+
 #include "model/ScoreboardModel.h"
 #include "view/GameboardView.h"
 #include "view/ScoreboardView.h"
@@ -26,25 +28,40 @@ State *PlayMachineState::run() {
     GameboardView gameboardView(gameboard);
     ScoreboardView scoreboardView(scoreboard);
 
-    searchStrategy->initialize(gameboard);
+    BackgroundSolver solver(searchStrategy);
+    solver.submit(gameboard);
 
     while(true) {
         getTerminal()->clear();
         gameboardView.draw(*getTerminal());
         scoreboardView.draw(*getTerminal());
+        switch(solver.getStatus()) {
+            case BackgroundSolver::SOLVING:
+                getTerminal()->drawStringAbsolute(pos_t(0, getTerminal()->getSize().y-2), "Solving..."); break;
+            case BackgroundSolver::FAILED:
+                getTerminal()->drawStringAbsolute(pos_t(0, getTerminal()->getSize().y-2), "Failed to find a solution"); break;
+            case BackgroundSolver::SOLVED:
+            default: break;
+        }
 
         getTerminal()->display();
 
         getchar();
-        GameboardModel::Move move = searchStrategy->next();
-
         if(gameboard.isGameOver()){
             break;
         }
 
+        GameboardModel::Move move(0, 0);
+        try {
+            move = solver.next();
+        } catch(const SearchStrategy::failed_to_find_solution &) {
+            break;
+        }
+
         if(gameboard.canMove(move)) {
             gameboard.move(move);
             scoreboard.addScore();
+            solver.submit(gameboard);
         } else {
             break;
         }
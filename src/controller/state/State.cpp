@@ -3,6 +3,8 @@
 
 #include "controller/state/State.h"
 
+const char *const State::solutionCachePath = "solutions.cache";
+
 MainMenuState                     *State::mainMenuState                     = nullptr;
 PlayHumanState                    *State::playHumanState                    = nullptr;
 ChooseStrategyState               *State::chooseMachineState                = nullptr;
@@ -2,7 +2,20 @@
 // Distributed under the terms of the GNU General Public License, version 3
 
 
+#include <deque>
+#include <iostream>
+#include <thread>
+
 #include "CommandLineInterface.h"
+#include "BatchSolver.h"
+#include "Benchmark.h"
+#include "DatasetGenerator.h"
+#include "ParameterSweep.h"
+#include "model/BoardGenerator.h"
+#include "model/BoardReader.h"
+#include "model/BoardWriter.h"
+#include "model/PackedBoard.h"
+#include "SolverService.h"
 #include "view/gui/TerminalGUIColor.h"
 #include "controller/state/State.h"
 
@@ -15,6 +28,106 @@ int main(int argc, char *argv[]){
         interface.run();
         return 0;
     }
+    if(argc >= 2 && string(argv[1]) == "bench"){
+        try {
+            Benchmark benchmark(vector<string>(argv+2, argv+argc));
+            benchmark.run();
+        } catch(const exception &e){
+            cerr << "Exception: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if(argc >= 2 && string(argv[1]) == "batch"){
+        try {
+            BatchSolver batch(vector<string>(argv+2, argv+argc));
+            batch.run();
+        } catch(const exception &e){
+            cerr << "Exception: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if(argc >= 4 && string(argv[1]) == "convert"){
+        try {
+            BoardReader reader(argv[2]);
+            BoardReader::Format format = (reader.getFormat() == BoardReader::TEXT ? BoardReader::BINARY : BoardReader::TEXT);
+            if(argc >= 5) format = (string(argv[4]) == "binary" ? BoardReader::BINARY : BoardReader::TEXT);
+            BoardWriter writer(argv[3], format);
+            GameboardModel gameboard;
+            while(reader.next(gameboard)) writer.write(gameboard);
+            writer.close();
+        } catch(const exception &e){
+            cerr << "Exception: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if(argc >= 7 && string(argv[1]) == "packcheck"){
+        try {
+            const size_t count   = static_cast<size_t>(atol(argv[2]));
+            const size_t nTubes  = static_cast<size_t>(atol(argv[3]));
+            const size_t tubeH   = static_cast<size_t>(atol(argv[4]));
+            const size_t nColors = static_cast<size_t>(atol(argv[5]));
+            const uint64_t seed  = strtoull(argv[6], nullptr, 10);
+            // Shuffled gameboards, and scrambled ones at all depths up to 2·nColors (so final states are checked too)
+            size_t nFailed = 0;
+            for(size_t i = 0; i < count; ++i) {
+                BoardGenerator generator(BoardGenerator::seedOf(seed, i));
+                const GameboardModel shuffled  = generator.shuffled (nTubes, tubeH, nColors);
+                const GameboardModel scrambled = generator.scrambled(nTubes, tubeH, nColors, i % (2*nColors + 1));
+                for(const GameboardModel *g: {&shuffled, &scrambled}) {
+                    if(PackedBoard::crossCheck(*g)) continue;
+                    ++nFailed;
+                    cerr << "Mismatch: board " << i << ": " << g->toText() << endl;
+                }
+            }
+            cout << 2*count << " gameboards, " << nFailed << " mismatches" << endl;
+            if(nFailed > 0) return 1;
+        } catch(const exception &e){
+            cerr << "Exception: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if(argc >= 2 && string(argv[1]) == "generate"){
+        try {
+            DatasetGenerator generator(vector<string>(argv+2, argv+argc));
+            generator.run();
+        } catch(const exception &e){
+            cerr << "Exception: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if(argc >= 2 && string(argv[1]) == "sweep"){
+        try {
+            ParameterSweep sweep(vector<string>(argv+2, argv+argc));
+            sweep.run();
+        } catch(const exception &e){
+            cerr << "Exception: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if(argc >= 2 && string(argv[1]) == "serve"){
+        deque<string> args(argv+2, argv+argc);
+        size_t nWorkers = max(thread::hardware_concurrency(), 1u);
+        size_t capacity = 64;
+        while(args.size() >= 2 && (args[0] == "workers" || args[0] == "queue")) {
+            (args[0] == "workers" ? nWorkers : capacity) = static_cast<size_t>(atol(args[1].c_str()));
+            args.erase(args.begin(), args.begin() + 2);
+        }
+        try {
+            SolverService service(nWorkers, capacity);
+            if(!args.empty()) service.serveSocket(args[0]);
+            else              service.serveStdin();
+        } catch(const exception &e){
+            cerr << "Exception: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
 
     TerminalGUI *terminal = new TerminalGUIColor();
     State::initializeStates(terminal);
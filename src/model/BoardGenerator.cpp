@@ -0,0 +1,99 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "model/BoardGenerator.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+BoardGenerator::BoardGenerator(uint64_t seed): rng(seed) {
+}
+
+uint64_t BoardGenerator::seedOf(uint64_t seed, uint64_t i) {
+    uint64_t x = seed + (i + 1) * 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+void BoardGenerator::check(size_t nTubes, size_t tubeH, size_t nColors) {
+    if(nColors == 0 || tubeH == 0) throw invalid_argument("there must be at least one color and one slot per tube");
+    if(nColors > nTubes) throw invalid_argument("more colors (" + to_string(nColors) + ") than tubes (" + to_string(nTubes) + ")");
+    if(nColors >= 255) throw invalid_argument("too many colors");
+}
+
+GameboardModel BoardGenerator::shuffled(size_t nTubes, size_t tubeH, size_t nColors) {
+    check(nTubes, tubeH, nColors);
+    const size_t nSlots = nTubes * tubeH, nPieces = nColors * tubeH;
+
+    // Choose which slots are filled: the first nPieces of a random permutation of the slots
+    vector<size_t> slots(nSlots);
+    for(size_t i = 0; i < nSlots; ++i) slots[i] = i / tubeH;
+    for(size_t i = 0; i < nPieces; ++i) swap(slots[i], slots[i + rng() % (nSlots - i)]);
+    vector<size_t> count(nTubes, 0);
+    for(size_t i = 0; i < nPieces; ++i) ++count[slots[i]];
+
+    // Shuffle pieces and lay them in the tubes
+    vector<uint8_t> pieces(nPieces);
+    for(size_t i = 0; i < nPieces; ++i) pieces[i] = uint8_t(i / tubeH + 1);
+    shuffle(pieces.begin(), pieces.end(), rng);
+
+    vector<uint8_t> packed(nSlots, 0);
+    size_t k = 0;
+    for(size_t t = 0; t < nTubes; ++t)
+        for(size_t h = 0; h < count[t]; ++h)
+            packed[t*tubeH + h] = pieces[k++];
+
+    GameboardModel ret;
+    ret.unpack(nTubes, tubeH, packed.data());
+    return ret;
+}
+
+GameboardModel BoardGenerator::scrambled(size_t nTubes, size_t tubeH, size_t nColors, size_t depth) {
+    check(nTubes, tubeH, nColors);
+
+    // Final state, with colors in random tubes
+    vector<uint8_t> packed(nTubes * tubeH, 0);
+    vector<size_t> tubes(nTubes);
+    for(size_t i = 0; i < nTubes; ++i) tubes[i] = i;
+    shuffle(tubes.begin(), tubes.end(), rng);
+    for(size_t c = 0; c < nColors; ++c)
+        fill(&packed[tubes[c]*tubeH], &packed[tubes[c]*tubeH] + tubeH, uint8_t(c + 1));
+    GameboardModel g;
+    g.unpack(nTubes, tubeH, packed.data());
+
+    // Random walk backwards
+    unordered_set<string> visited;
+    auto key = [&g, &packed]() {
+        g.pack(packed.data());
+        return string(packed.begin(), packed.end());
+    };
+    visited.insert(key());
+    Move last(0, 0);
+    vector<Move> candidates;
+    for(size_t step = 0; step < depth; ++step) {
+        vector<Move> moves = g.getAllReverseMoves();
+        candidates.clear();
+        for(const Move &m: moves) {
+            if(step > 0 && m == Move(last.to, last.from)) continue;
+            GameboardModel v = g;
+            v.reverseMove(m);
+            v.pack(packed.data());
+            if(!visited.count(string(packed.begin(), packed.end()))) candidates.push_back(m);
+        }
+        if(candidates.empty()) {
+            for(const Move &m: moves) if(step == 0 || m != Move(last.to, last.from)) candidates.push_back(m);
+        }
+        if(candidates.empty()) break;
+        last = candidates[rng() % candidates.size()];
+        g.reverseMove(last);
+        visited.insert(key());
+    }
+    return g;
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "model/BoardReader.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+const char BoardReader::MAGIC[8] = {'B', 'S', 'B', 'O', 'A', 'R', 'D', 1};
+
+BoardReader::BoardReader(const string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) throw runtime_error("failed to open " + path);
+    struct stat st{};
+    if(fstat(fd, &st) != 0){ close(fd); throw runtime_error("failed to open " + path); }
+    dataSize = static_cast<size_t>(st.st_size);
+    if(dataSize > 0) {
+        void *p = mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(p == MAP_FAILED){ close(fd); throw runtime_error("failed to map " + path); }
+        madvise(p, dataSize, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(p);
+    }
+    close(fd);
+
+    if(dataSize >= sizeof(MAGIC) && memcmp(data, MAGIC, sizeof(MAGIC)) == 0) {
+        format = BINARY;
+        pos = sizeof(MAGIC);
+    }
+}
+
+BoardReader::Format BoardReader::getFormat() const {
+    return format;
+}
+
+bool BoardReader::next(GameboardModel &gameboard) {
+    if(format == BINARY) {
+        if(pos == dataSize) return false;
+        const uint8_t *p = reinterpret_cast<const uint8_t*>(data + pos);
+        const size_t nTubes = (dataSize - pos < 4 ? 0 : size_t(p[0]) | size_t(p[1]) << 8);
+        const size_t tubeH  = (dataSize - pos < 4 ? 0 : size_t(p[2]) | size_t(p[3]) << 8);
+        if(dataSize - pos < 4 || dataSize - pos - 4 < nTubes*tubeH) {
+            const size_t at = pos;
+            pos = dataSize;
+            throw invalid_argument("truncated board at byte " + to_string(at));
+        }
+        gameboard.unpack(nTubes, tubeH, p + 4);
+        pos += 4 + nTubes*tubeH;
+        return true;
+    }
+
+    while(pos < dataSize) {
+        const char *end = static_cast<const char*>(memchr(data + pos, '\n', dataSize - pos));
+        const size_t len = (end != nullptr ? size_t(end - (data + pos)) : dataSize - pos);
+        string s(data + pos, len);
+        pos += len + 1;
+        ++line;
+        if(!s.empty() && s.back() == '\r') s.pop_back();
+        if(s.empty() || s[0] == '#') continue;
+        try {
+            gameboard.fromText(s);
+        } catch(const invalid_argument &e) {
+            throw invalid_argument("line " + to_string(line) + ": " + e.what());
+        }
+        return true;
+    }
+    pos = dataSize;
+    return false;
+}
+
+BoardReader::~BoardReader() {
+    if(data != nullptr) munmap(const_cast<char*>(data), dataSize);
+}
@@ -0,0 +1,50 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "model/BoardWriter.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+BoardWriter::BoardWriter(const string &path, BoardReader::Format fmt):
+    file(path == "-" ? stdout : fopen(path.c_str(), "wb")),
+    format(fmt)
+{
+    if(file == nullptr) throw runtime_error("failed to create " + path);
+    if(format == BoardReader::BINARY && fwrite(BoardReader::MAGIC, sizeof(BoardReader::MAGIC), 1, file) != 1)
+        throw runtime_error("failed to write board file");
+}
+
+void BoardWriter::write(const GameboardModel &gameboard) {
+    bool ok;
+    if(format == BoardReader::TEXT) {
+        const string s = gameboard.toText() + "\n";
+        ok = (fwrite(s.data(), 1, s.size(), file) == s.size());
+    } else {
+        const size_t nTubes = gameboard.size(), tubeH = gameboard.tubeHeight();
+        if(nTubes > 0xFFFF || tubeH > 0xFFFF) throw invalid_argument("gameboard is too large");
+        // Pieces are packed as color+1 in one byte
+        if(gameboard.getNumberOfColors() > 254)
+            throw invalid_argument(to_string(gameboard.getNumberOfColors()) + " colors cannot be written as binary");
+        vector<uint8_t> record(4 + gameboard.packedSize());
+        record[0] = uint8_t(nTubes); record[1] = uint8_t(nTubes >> 8);
+        record[2] = uint8_t(tubeH ); record[3] = uint8_t(tubeH  >> 8);
+        gameboard.pack(record.data() + 4);
+        ok = (fwrite(record.data(), 1, record.size(), file) == record.size());
+    }
+    if(!ok) throw runtime_error("failed to write board file");
+}
+
+void BoardWriter::close() {
+    if(file == nullptr) return;
+    const bool ok = (file == stdout ? fflush(file) : fclose(file)) == 0;
+    file = nullptr;
+    if(!ok) throw runtime_error("failed to write board file");
+}
+
+BoardWriter::~BoardWriter() {
+    if(file != nullptr && file != stdout) fclose(file);
+    else if(file == stdout) fflush(file);
+}
@@ -5,10 +5,19 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <cstdlib>
+#include <mutex>
 
 using namespace std;
 using Move = GameboardModel::Move;
 
+namespace {
+    /**
+     * @brief Serializes use of the global random generator, which fillRandom(size_t, unsigned) seeds and draws from.
+     */
+    mutex randomMutex;
+}
+
 GameboardModel::Move::Move(size_t f, size_t t):from(f), to(t) {
 }
 
@@ -62,6 +71,8 @@ void GameboardModel::clear(){
 }
 
 void GameboardModel::fillRandom(size_t num_colors, unsigned sd){
+    // The same seed must always give the same board, even if other threads generate boards at the same time
+    lock_guard<mutex> lock(randomMutex);
     this->seed = sd;
     srand(sd);
     size_t num_pieces = num_colors * tubeH;
@@ -184,6 +195,21 @@ vector<Move> GameboardModel::getAllMoves() const {
     return result;
 }
 
+vector<Move> GameboardModel::getAllReverseMoves() const {
+    vector<Move> result;
+
+    for (size_t i = 0 ; i < this->size() ; i++){
+        if (this->at(i).size() >= tubeH) continue;
+        for (size_t j = 0 ; j < this->size() ; j++){
+            if(i == j || this->at(j).empty()) continue;
+            Move m(i, j);
+            if (canReverseMove(m)) result.push_back(m);
+        }
+    }
+
+    return result;
+}
+
 vector<GameboardModel> GameboardModel::getAdjacentStates() const {
     vector<GameboardModel> result;
 
@@ -252,6 +278,89 @@ unsigned GameboardModel::getSeed() const {
     return seed;
 }
 
+size_t GameboardModel::getHeapSize() const {
+    // libstdc++ allocates a deque as 512-byte buffers plus a map with a pointer per buffer (at least 8), and keeps one
+    // buffer even when empty
+    const size_t perBuffer = max<size_t>(1, 512 / sizeof(color_t));
+    size_t ret = tubes.capacity() * sizeof(Tube);
+    for(const Tube &t: tubes) {
+        const size_t nBuffers = t.size() / perBuffer + 1;
+        ret += nBuffers * perBuffer * sizeof(color_t) + max<size_t>(8, nBuffers + 2) * sizeof(color_t*);
+    }
+    return ret;
+}
+
+size_t GameboardModel::packedSize() const {
+    return nTubes * tubeH;
+}
+
+void GameboardModel::pack(uint8_t *out) const {
+    for(const Tube &t: tubes){
+        size_t i = 0;
+        for(; i < t.size(); ++i) out[i] = uint8_t(t[i] + 1);
+        for(; i < tubeH; ++i) out[i] = 0;
+        out += tubeH;
+    }
+}
+
+void GameboardModel::unpack(const uint8_t *in) {
+    for(Tube &t: tubes){
+        t.clear();
+        for(size_t i = 0; i < tubeH && in[i] != 0; ++i) t.push_back(color_t(in[i] - 1));
+        in += tubeH;
+    }
+}
+
+void GameboardModel::unpack(size_t num_tubes, size_t tube_height, const uint8_t *in) {
+    nTubes = num_tubes;
+    tubeH = tube_height;
+    tubes.assign(nTubes, Tube());
+    unpack(in);
+    nColors = 0;
+    for(size_t i = 0; i < nTubes*tubeH; ++i) nColors = max(nColors, size_t(in[i]));
+    seed = 0;
+}
+
+namespace {
+    const string TEXT_COLORS = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+}
+
+string GameboardModel::toText() const {
+    string ret = to_string(tubeH) + ":";
+    for(size_t i = 0; i < tubes.size(); ++i) {
+        if(i > 0) ret += '/';
+        for(const color_t &c: tubes[i]) {
+            if(c >= TEXT_COLORS.size()) throw invalid_argument("color " + to_string(c) + " cannot be written as text");
+            ret += TEXT_COLORS[c];
+        }
+    }
+    return ret;
+}
+
+void GameboardModel::fromText(const string &text) {
+    const size_t colon = text.find(':');
+    if(colon == string::npos || colon == 0 || text.find_first_not_of("0123456789") < colon)
+        throw invalid_argument("malformed board: " + text);
+    const size_t H = static_cast<size_t>(atol(text.substr(0, colon).c_str()));
+    if(H == 0) throw invalid_argument("malformed board: " + text);
+
+    vector<uint8_t> packed;
+    size_t n = 0, h = 0;
+    packed.resize(H, 0);
+    for(size_t i = colon+1; i < text.size(); ++i) {
+        const char ch = text[i];
+        if(ch == '/') {
+            ++n; h = 0;
+            packed.resize((n+1)*H, 0);
+            continue;
+        }
+        const size_t c = TEXT_COLORS.find(ch);
+        if(c == string::npos || h >= H) throw invalid_argument("malformed board: " + text);
+        packed[n*H + h++] = uint8_t(c + 1);
+    }
+    unpack(n+1, H, packed.data());
+}
+
 size_t std::hash<Tube>::operator()(const Tube &vec) const {
     size_t seed = vec.size();
     for (auto &i : vec) {
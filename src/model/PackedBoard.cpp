@@ -0,0 +1,217 @@
+// Copyright (C) 2021 Diogo Rodrigues, Rafael Ribeiro, Bernardo Ferreira
+// Distributed under the terms of the GNU General Public License, version 3
+
+#include "model/PackedBoard.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PACKED_BOARD_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using Move = GameboardModel::Move;
+
+namespace {
+    typedef void (*scan_t)(const uint8_t *p, size_t R, uint64_t *nonEmpty, uint64_t *sameAbove);
+
+    /**
+     * @brief Scan slots [k, R) one at a time; bitmaps must be zero in that range.
+     */
+    void scanTail(const uint8_t *p, size_t k, size_t R, uint64_t *nonEmpty, uint64_t *sameAbove) {
+        for(; k < R; ++k) {
+            if(p[k] != 0)                   nonEmpty [k/64] |= uint64_t(1) << (k%64);
+            if(k+1 < R && p[k] == p[k+1])   sameAbove[k/64] |= uint64_t(1) << (k%64);
+        }
+    }
+
+    void scanScalar(const uint8_t *p, size_t R, uint64_t *nonEmpty, uint64_t *sameAbove) {
+        scanTail(p, 0, R, nonEmpty, sameAbove);
+    }
+
+#ifdef PACKED_BOARD_X86
+    __attribute__((target("sse2")))
+    void scanSse2(const uint8_t *p, size_t R, uint64_t *nonEmpty, uint64_t *sameAbove) {
+        const __m128i zero = _mm_setzero_si128();
+        uint8_t *ne = reinterpret_cast<uint8_t*>(nonEmpty);
+        uint8_t *sa = reinterpret_cast<uint8_t*>(sameAbove);
+        size_t k = 0;
+        for(; k + 16 < R; k += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+            const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k + 1));
+            const uint16_t n = static_cast<uint16_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)));
+            const uint16_t s = static_cast<uint16_t>( _mm_movemask_epi8(_mm_cmpeq_epi8(v, w   )));
+            memcpy(ne + k/8, &n, sizeof(n));
+            memcpy(sa + k/8, &s, sizeof(s));
+        }
+        scanTail(p, k, R, nonEmpty, sameAbove);
+    }
+
+    __attribute__((target("avx2")))
+    void scanAvx2(const uint8_t *p, size_t R, uint64_t *nonEmpty, uint64_t *sameAbove) {
+        const __m256i zero = _mm256_setzero_si256();
+        uint8_t *ne = reinterpret_cast<uint8_t*>(nonEmpty);
+        uint8_t *sa = reinterpret_cast<uint8_t*>(sameAbove);
+        size_t k = 0;
+        for(; k + 32 < R; k += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k));
+            const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k + 1));
+            const uint32_t n = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+            const uint32_t s =  static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, w   )));
+            memcpy(ne + k/8, &n, sizeof(n));
+            memcpy(sa + k/8, &s, sizeof(s));
+        }
+        scanTail(p, k, R, nonEmpty, sameAbove);
+    }
+#endif
+
+    PackedBoard::Isa detectIsa() {
+#ifdef PACKED_BOARD_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return PackedBoard::AVX2;
+        if(__builtin_cpu_supports("sse2")) return PackedBoard::SSE2;
+#endif
+        return PackedBoard::SCALAR;
+    }
+
+    scan_t scanOf(PackedBoard::Isa isa) {
+        switch(isa) {
+#ifdef PACKED_BOARD_X86
+            case PackedBoard::AVX2: return scanAvx2;
+            case PackedBoard::SSE2: return scanSse2;
+#else
+            case PackedBoard::AVX2:
+            case PackedBoard::SSE2:
+#endif
+            case PackedBoard::SCALAR:
+            default: return scanScalar;
+        }
+    }
+
+    /**
+     * @brief Get len bits (at most 64) of a bitmap, starting at bit pos.
+     */
+    uint64_t extract(const vector<uint64_t> &bitmap, size_t pos, size_t len) {
+        if(len == 0) return 0;
+        const size_t i = pos/64, o = pos%64;
+        uint64_t ret = bitmap[i] >> o;
+        if(o != 0 && o + len > 64) ret |= bitmap[i+1] << (64 - o);
+        return (len == 64 ? ret : ret & ((uint64_t(1) << len) - 1));
+    }
+}
+
+PackedBoard::Isa PackedBoard::isa = detectIsa();
+
+PackedBoard::PackedBoard(size_t num_tubes, size_t tube_height):
+    nTubes(num_tubes),
+    tubeH(tube_height),
+    nonEmpty ((num_tubes*tube_height)/64 + 1, 0),
+    sameAbove((num_tubes*tube_height)/64 + 1, 0),
+    sizes(num_tubes, 0),
+    runs(num_tubes, 0),
+    topMask(256, 0)
+{
+    if(tubeH == 0 || tubeH > 64) throw invalid_argument("PackedBoard: tube height must be between 1 and 64");
+}
+
+PackedBoard::Isa PackedBoard::getIsa() {
+    return isa;
+}
+
+PackedBoard::Isa PackedBoard::setIsa(Isa i) {
+    isa = min(i, detectIsa());
+    return isa;
+}
+
+bool PackedBoard::crossCheck(const GameboardModel &gameboard) {
+    const size_t n = gameboard.size(), H = gameboard.tubeHeight();
+    vector<uint8_t> packed(gameboard.packedSize()), moved(packed.size()), expected(packed.size());
+    gameboard.pack(packed.data());
+    const bool gameOver = gameboard.isGameOver();
+    const vector<GameboardModel::Move> moves = gameboard.getAllMoves();
+
+    const Isa previous = isa;
+    bool ok = true;
+    PackedBoard b(n, H);
+    vector<GameboardModel::Move> out;
+    for(const Isa i: {SCALAR, SSE2, AVX2}) {
+        if(setIsa(i) != i) continue;
+        b.load(packed.data());
+        b.getAllMoves(out);
+        ok = ok && b.isGameOver() == gameOver && out == moves;
+        for(size_t k = 0; ok && k < moves.size(); ++k) {
+            GameboardModel g = gameboard;
+            g.move(moves[k]);
+            g.pack(expected.data());
+            b.move(moves[k], moved.data());
+            ok = (moved == expected);
+        }
+    }
+    isa = previous;
+    return ok;
+}
+
+void PackedBoard::load(const uint8_t *p) {
+    board = p;
+    fill(nonEmpty .begin(), nonEmpty .end(), 0);
+    fill(sameAbove.begin(), sameAbove.end(), 0);
+    scanOf(isa)(p, nTubes*tubeH, nonEmpty.data(), sameAbove.data());
+
+    for(size_t i = 0; i < nTubes; ++i) {
+        sizes[i] = static_cast<size_t>(__builtin_popcountll(extract(nonEmpty, i*tubeH, tubeH)));
+        runs [i] = 1 + static_cast<size_t>(__builtin_ctzll(~extract(sameAbove, i*tubeH, tubeH-1)));
+    }
+
+    if(nTubes <= 64) {
+        emptyMask = notFullMask = 0;
+        for(size_t i = 0; i < nTubes; ++i) topMask[getTop(i)] = 0;
+        for(size_t i = 0; i < nTubes; ++i) {
+            const uint64_t bit = uint64_t(1) << i;
+            if(sizes[i] == 0) emptyMask |= bit;
+            else              topMask[getTop(i)] |= bit;
+            if(sizes[i] < tubeH) notFullMask |= bit;
+        }
+    }
+}
+
+size_t PackedBoard::size() const { return nTubes; }
+size_t PackedBoard::tubeHeight() const { return tubeH; }
+size_t PackedBoard::getSize(size_t i) const { return sizes[i]; }
+uint8_t PackedBoard::getBottom(size_t i) const { return board[i*tubeH]; }
+uint8_t PackedBoard::getTop(size_t i) const { return (sizes[i] == 0 ? 0 : board[i*tubeH + sizes[i] - 1]); }
+size_t PackedBoard::getBottomRun(size_t i) const { return (sizes[i] == 0 ? 0 : runs[i]); }
+
+bool PackedBoard::isGameOver() const {
+    for(size_t i = 0; i < nTubes; ++i)
+        if(runs[i] != tubeH) return false;
+    return true;
+}
+
+void PackedBoard::getAllMoves(vector<Move> &out) const {
+    out.clear();
+    if(nTubes <= 64) {
+        for(size_t i = 0; i < nTubes; ++i) {
+            if(sizes[i] == 0) continue;
+            uint64_t candidates = notFullMask & (emptyMask | topMask[getTop(i)]) & ~(uint64_t(1) << i);
+            for(; candidates != 0; candidates &= candidates - 1)
+                out.emplace_back(i, static_cast<size_t>(__builtin_ctzll(candidates)));
+        }
+    } else {
+        for(size_t i = 0; i < nTubes; ++i) {
+            if(sizes[i] == 0) continue;
+            for(size_t j = 0; j < nTubes; ++j)
+                if(j != i && sizes[j] < tubeH && (sizes[j] == 0 || getTop(j) == getTop(i)))
+                    out.emplace_back(i, j);
+        }
+    }
+}
+
+void PackedBoard::move(const Move &m, uint8_t *out) const {
+    if(out != board) memcpy(out, board, nTubes*tubeH);
+    uint8_t &src = out[m.from*tubeH + sizes[m.from] - 1];
+    out[m.to*tubeH + sizes[m.to]] = src;
+    src = 0;
+}
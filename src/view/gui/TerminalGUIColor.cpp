@@ -3,6 +3,7 @@
 
 #include "view/gui/TerminalGUIColor.h"
 
+#include <stdexcept>
 #include <vector>
 
 using namespace std;
@@ -1,5 +1,7 @@
 #include "view/gui/TerminalGUISprite.h"
 
+#include <stdexcept>
+
 using namespace std;
 
 using coord_t   = TerminalGUI::coord_t;